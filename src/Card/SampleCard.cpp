@@ -3,6 +3,7 @@
 #include <QGridLayout>
 #include "StyleSheet.h"
 #include "Theme.h"
+#include "../Common/BackgroundRepaintCoalescer.h"
 
 SampleCard::SampleCard(const QString &icon, const QString &title, const QString &content,
                        const QString &routeKey, int index, QWidget *parent)
@@ -22,6 +23,8 @@ SampleCard::SampleCard(const QString &icon, const QString &title, const QString
     m_subTitleLabel->setContentsMargins(13, 0, 0, 0);
 
     initWidget();
+
+    BackgroundRepaintCoalescer::instance()->attach(this);
 }
 
 void SampleCard::initWidget()
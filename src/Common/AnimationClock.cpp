@@ -0,0 +1,348 @@
+#include "AnimationClock.h"
+
+#include <algorithm>
+
+#include <QTimer>
+#include <QWidget>
+#include <QCoreApplication>
+#include <QVariantAnimation>
+
+namespace {
+constexpr int kDefaultFrameInterval = 16;
+
+bool isNumeric(const QVariant &value)
+{
+    switch (value.userType()) {
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Float:
+    case QMetaType::Double:
+        return true;
+    default:
+        return false;
+    }
+}
+}
+
+AnimationClock *AnimationClock::instance()
+{
+    static AnimationClock *clock = new AnimationClock(QCoreApplication::instance());
+    return clock;
+}
+
+AnimationClock::AnimationClock(QObject *parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+    , m_nextId(1)
+    , m_isTicking(false)
+    , m_isPaused(false)
+    , m_pausedAt(0)
+{
+    m_timer->setTimerType(Qt::PreciseTimer);
+    m_timer->setInterval(kDefaultFrameInterval);
+    connect(m_timer, &QTimer::timeout, this, &AnimationClock::tick);
+
+    m_clock.start();
+}
+
+AnimationClock::Spec AnimationClock::specFor(FluentAnimationType type, FluentAnimationSpeed speed)
+{
+    static QHash<int, Spec> specs;
+
+    const int key = int(type) * 4 + int(speed);
+    auto it = specs.constFind(key);
+    if (it != specs.constEnd()) {
+        return it.value();
+    }
+
+    // 借工厂创建一次原型，只读取时长和曲线
+    Spec spec;
+    if (FluentAnimation *prototype = FluentAnimation::create(type, FluentAnimationProperty::OPACITY, speed)) {
+        spec.duration = prototype->duration();
+        spec.curve = prototype->easingCurve();
+
+        // 删除原型前先确定目标的归属：挂在原型下的目标随原型释放，没有父对象的目标由这里释放
+        QObject *target = prototype->targetObject();
+        const bool isTargetOrphan = target && !target->parent();
+        delete prototype;
+        if (isTargetOrphan) {
+            delete target;
+        }
+    }
+
+    specs.insert(key, spec);
+    return spec;
+}
+
+AnimationClock::TweenId AnimationClock::start(qreal from, qreal to, const Spec &spec, Setter setter,
+                                              QWidget *repaintTarget, QObject *context, Callback finished)
+{
+    Tween tween;
+    tween.id = m_nextId++;
+    tween.startTime = m_isPaused ? m_pausedAt : m_clock.elapsed();
+    tween.duration = qMax(1, spec.duration);
+    tween.from = from;
+    tween.to = to;
+    tween.hasCurve = spec.hasCurve && spec.curve.type() != QEasingCurve::Linear;
+    if (tween.hasCurve) {
+        tween.curve = spec.curve;
+    }
+    tween.setter = std::move(setter);
+    tween.finished = std::move(finished);
+    tween.repaintTarget = repaintTarget;
+    tween.context = context;
+    tween.hasContext = context != nullptr;
+
+    // 与 QVariantAnimation 一样，启动时先写入起始值
+    if (tween.setter) {
+        tween.setter(from);
+    }
+    if (repaintTarget) {
+        repaintTarget->update();
+    }
+
+    const TweenId id = tween.id;
+    if (m_isTicking) {
+        m_incoming.push_back(std::move(tween));
+    } else {
+        m_tweens.push_back(std::move(tween));
+    }
+
+    updateTimer();
+    return id;
+}
+
+AnimationClock::TweenId AnimationClock::start(FluentAnimationType type, FluentAnimationSpeed speed,
+                                              qreal from, qreal to, Setter setter,
+                                              QWidget *repaintTarget, QObject *context, Callback finished)
+{
+    return start(from, to, specFor(type, speed), std::move(setter), repaintTarget, context, std::move(finished));
+}
+
+AnimationClock::TweenId AnimationClock::start(const QVariantAnimation *prototype, Setter setter,
+                                              QWidget *repaintTarget, QObject *context, Callback finished)
+{
+    // 时钟只推进 qreal，QPoint、QColor 等类型的动画无法换算，不启动
+    const QVariant startValue = prototype->startValue().isValid() ? prototype->startValue() : prototype->currentValue();
+    const QVariant endValue = prototype->endValue();
+    if (!isNumeric(startValue) || !isNumeric(endValue)) {
+        return 0;
+    }
+
+    Spec spec;
+    spec.duration = prototype->duration();
+    spec.curve = prototype->easingCurve();
+
+    return start(startValue.toReal(), endValue.toReal(), spec,
+                 std::move(setter), repaintTarget, context, std::move(finished));
+}
+
+void AnimationClock::stop(TweenId id, bool jumpToEnd)
+{
+    if (id == 0) {
+        return;
+    }
+
+    for (std::vector<Tween> *tweens : {&m_tweens, &m_incoming}) {
+        auto it = std::find_if(tweens->begin(), tweens->end(), [id](const Tween &t) { return t.id == id; });
+        if (it == tweens->end()) {
+            continue;
+        }
+
+        // 先取出回调再清理：回调中可能再次启动补间，导致数组扩容
+        const Setter setter = jumpToEnd ? it->setter : Setter();
+        const Callback finished = jumpToEnd ? it->finished : Callback();
+        const QPointer<QWidget> repaintTarget = it->repaintTarget;
+        const qreal to = it->to;
+        it->id = 0;
+
+        // 推进过程中只做标记，由 tick 结束时统一清理，不在回调执行中析构 setter
+        if (!m_isTicking) {
+            tweens->erase(it);
+            updateTimer();
+        }
+
+        if (setter) {
+            setter(to);
+        }
+        if (jumpToEnd && repaintTarget) {
+            repaintTarget->update();
+        }
+        if (finished) {
+            finished();
+        }
+        return;
+    }
+}
+
+void AnimationClock::stopAll(const QObject *context)
+{
+    for (std::vector<Tween> *tweens : {&m_tweens, &m_incoming}) {
+        for (Tween &tween : *tweens) {
+            if (tween.hasContext && tween.context == context) {
+                tween.id = 0;
+            }
+        }
+        if (!m_isTicking) {
+            tweens->erase(std::remove_if(tweens->begin(), tweens->end(),
+                                         [](const Tween &t) { return t.id == 0; }),
+                          tweens->end());
+        }
+    }
+    updateTimer();
+}
+
+bool AnimationClock::isRunning(TweenId id) const
+{
+    if (id == 0) {
+        return false;
+    }
+
+    for (const std::vector<Tween> *tweens : {&m_tweens, &m_incoming}) {
+        for (const Tween &tween : *tweens) {
+            if (tween.id == id) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+int AnimationClock::activeCount() const
+{
+    int count = 0;
+    for (const std::vector<Tween> *tweens : {&m_tweens, &m_incoming}) {
+        for (const Tween &tween : *tweens) {
+            if (tween.id != 0) {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+void AnimationClock::setPaused(bool isPaused)
+{
+    if (m_isPaused == isPaused) {
+        return;
+    }
+
+    m_isPaused = isPaused;
+    if (m_isPaused) {
+        m_pausedAt = m_clock.elapsed();
+    } else {
+        // 暂停期间的时间不计入补间进度
+        const qint64 delta = m_clock.elapsed() - m_pausedAt;
+        for (Tween &tween : m_tweens) {
+            tween.startTime += delta;
+        }
+    }
+    updateTimer();
+}
+
+void AnimationClock::setFrameInterval(int msec)
+{
+    m_timer->setInterval(qMax(1, msec));
+}
+
+int AnimationClock::frameInterval() const
+{
+    return m_timer->interval();
+}
+
+void AnimationClock::tick()
+{
+    if (m_isPaused) {
+        return;
+    }
+
+    m_isTicking = true;
+    const qint64 now = m_clock.elapsed();
+
+    // 按下标遍历：推进期间 m_tweens 不会扩容，新补间进入 m_incoming
+    for (size_t i = 0; i < m_tweens.size(); ++i) {
+        Tween &tween = m_tweens[i];
+        if (tween.id == 0) {
+            continue;
+        }
+        if (tween.hasContext && !tween.context) {
+            tween.id = 0;
+            continue;
+        }
+
+        const qreal progress = qBound<qreal>(0, qreal(now - tween.startTime) / tween.duration, 1);
+        if (tween.setter) {
+            const qreal value = tween.hasCurve ? tween.curve.valueForProgress(progress) : progress;
+            tween.setter(tween.from + (tween.to - tween.from) * value);
+        }
+        if (tween.repaintTarget) {
+            scheduleRepaint(tween.repaintTarget);
+        }
+        if (progress >= 1 && tween.id != 0) {
+            finishTween(tween);
+        }
+    }
+
+    m_isTicking = false;
+
+    m_tweens.erase(std::remove_if(m_tweens.begin(), m_tweens.end(),
+                                  [](const Tween &t) { return t.id == 0; }),
+                   m_tweens.end());
+    for (Tween &tween : m_incoming) {
+        if (tween.id != 0) {
+            m_tweens.push_back(std::move(tween));
+        }
+    }
+    m_incoming.clear();
+
+    flushRepaints();
+    updateTimer();
+}
+
+void AnimationClock::finishTween(Tween &tween)
+{
+    tween.id = 0;
+    if (tween.finished) {
+        const Callback finished = tween.finished;
+        tween.finished = Callback();
+        finished();
+    }
+}
+
+void AnimationClock::scheduleRepaint(QWidget *widget)
+{
+    if (!widget->isVisible()) {
+        return;
+    }
+
+    QWidget *window = widget->window();
+    const QPoint pos = widget == window ? QPoint(0, 0) : widget->mapTo(window, QPoint(0, 0));
+    m_dirtyRegions[window] += QRect(pos, widget->size());
+}
+
+void AnimationClock::flushRepaints()
+{
+    // 同一窗口下各控件的脏区合并为一次 update，由重绘管理器一次性刷新
+    const QHash<QWidget *, QRegion> regions = m_dirtyRegions;
+    m_dirtyRegions.clear();
+
+    for (auto it = regions.constBegin(); it != regions.constEnd(); ++it) {
+        it.key()->update(it.value());
+    }
+}
+
+void AnimationClock::updateTimer()
+{
+    const bool isActive = !m_isPaused && (!m_tweens.empty() || !m_incoming.empty());
+    if (isActive && !m_timer->isActive()) {
+        m_timer->start();
+    } else if (!isActive && m_timer->isActive()) {
+        m_timer->stop();
+    }
+}
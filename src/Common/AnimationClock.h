@@ -0,0 +1,138 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+
+#include <QHash>
+#include <QObject>
+#include <QRegion>
+#include <QPointer>
+#include <QEasingCurve>
+#include <QElapsedTimer>
+
+#include "Animation.h"
+
+class QTimer;
+class QWidget;
+class QVariantAnimation;
+
+/**
+ * @brief 全局动画时钟
+ *
+ * 所有补间以普通结构体存放在连续数组中，由一个只在有补间时运行的定时器每帧统一推进，
+ * 数值通过 std::function 直接写给类型化的 setter，不经过 QVariant 和属性系统。
+ * 补间可以指定需要重绘的控件，同一帧内同一顶层窗口下的重绘区域合并为一次 update。
+ *
+ * 时长和缓动曲线可以直接取自 FluentAnimation::create 创建的同类型动画，
+ * 与库内控件的动画节奏保持一致。
+ */
+class AnimationClock : public QObject
+{
+    Q_OBJECT
+
+public:
+    using TweenId = quint64;
+    using Setter = std::function<void(qreal)>;
+    using Callback = std::function<void()>;
+
+    struct Spec {
+        int duration = 250;
+        QEasingCurve curve = QEasingCurve::OutQuad;
+
+        /**
+         * @brief 为 false 时不经过 curve，setter 直接收到按线性进度插值的值，
+         *        由调用方自行做缓动（例如 FluentTween 的 EasingTable）；Linear 曲线同样不经过 curve
+         */
+        bool hasCurve = true;
+    };
+
+    static AnimationClock *instance();
+
+    /**
+     * @brief 与 FluentAnimation::create(type, ..., speed) 相同的时长和曲线（结果按类型缓存）
+     */
+    static Spec specFor(FluentAnimationType type, FluentAnimationSpeed speed = FluentAnimationSpeed::FAST);
+
+    /**
+     * @brief 启动补间
+     * @param setter 每帧写入当前值
+     * @param repaintTarget 每帧需要重绘的控件，可为空
+     * @param context 生命周期对象，销毁后补间自动移除，可为空
+     * @return 补间编号，用于 stop / isRunning
+     */
+    TweenId start(qreal from, qreal to, const Spec &spec, Setter setter,
+                  QWidget *repaintTarget = nullptr, QObject *context = nullptr, Callback finished = Callback());
+
+    TweenId start(FluentAnimationType type, FluentAnimationSpeed speed, qreal from, qreal to, Setter setter,
+                  QWidget *repaintTarget = nullptr, QObject *context = nullptr, Callback finished = Callback());
+
+    /**
+     * @brief 以已有 QVariantAnimation（例如 FluentAnimation::create 的返回值）的
+     *        起止值、时长和曲线启动补间，原动画对象不再需要启动
+     * @return 补间编号；起止值不是数值类型时不启动，返回 0
+     */
+    TweenId start(const QVariantAnimation *prototype, Setter setter,
+                  QWidget *repaintTarget = nullptr, QObject *context = nullptr, Callback finished = Callback());
+
+    /**
+     * @brief 停止补间
+     * @param jumpToEnd 为 true 时先写入终值并调用完成回调
+     */
+    void stop(TweenId id, bool jumpToEnd = false);
+
+    /**
+     * @brief 停止与 context 关联的所有补间
+     */
+    void stopAll(const QObject *context);
+
+    bool isRunning(TweenId id) const;
+    int activeCount() const;
+
+    /**
+     * @brief 暂停时钟，恢复后各补间从暂停处继续
+     */
+    void setPaused(bool isPaused);
+    bool isPaused() const { return m_isPaused; }
+
+    void setFrameInterval(int msec);
+    int frameInterval() const;
+
+private:
+    struct Tween {
+        TweenId id;
+        qint64 startTime;
+        int duration;
+        qreal from;
+        qreal to;
+        QEasingCurve curve;
+        bool hasCurve;
+        Setter setter;
+        Callback finished;
+        QPointer<QWidget> repaintTarget;
+        QPointer<QObject> context;
+        bool hasContext;
+    };
+
+    explicit AnimationClock(QObject *parent = nullptr);
+
+    void tick();
+    void finishTween(Tween &tween);
+    void scheduleRepaint(QWidget *widget);
+    void flushRepaints();
+    void updateTimer();
+
+    QTimer *m_timer;
+    QElapsedTimer m_clock;
+    TweenId m_nextId;
+
+    // 正在推进的补间；推进过程中新启动的补间先放入 m_incoming，避免迭代时扩容
+    std::vector<Tween> m_tweens;
+    std::vector<Tween> m_incoming;
+    bool m_isTicking;
+
+    bool m_isPaused;
+    qint64 m_pausedAt;
+
+    // 顶层窗口 -> 本帧需要重绘的区域
+    QHash<QWidget *, QRegion> m_dirtyRegions;
+};
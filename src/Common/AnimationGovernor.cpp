@@ -0,0 +1,322 @@
+#include "AnimationGovernor.h"
+
+#include <QEvent>
+#include <QTimer>
+#include <QWidget>
+#include <QWindow>
+#include <QCoreApplication>
+#include <QAbstractAnimation>
+
+#include "Animation.h"
+#include "AnimationClock.h"
+#include "QFluent/Progress/IndeterminateProgressBar.h"
+#include "QFluent/Progress/IndeterminateProgressRing.h"
+
+namespace {
+constexpr int kDebugInterval = 1000;
+}
+
+AnimationGovernor *AnimationGovernor::instance()
+{
+    static AnimationGovernor *governor = new AnimationGovernor(QCoreApplication::instance());
+    return governor;
+}
+
+AnimationGovernor::AnimationGovernor(QObject *parent)
+    : QObject(parent)
+    , m_isSuspended(false)
+    , m_debugTimer(nullptr)
+    , m_timerEvents(0)
+    , m_timerWakeupsPerSecond(0)
+{
+}
+
+void AnimationGovernor::watch(QWidget *window)
+{
+    if (!window) {
+        return;
+    }
+
+    window = window->window();
+    for (const WatchedWindow &watched : m_windows) {
+        if (watched.widget == window) {
+            return;
+        }
+    }
+
+    WatchedWindow watched;
+    watched.widget = window;
+    attachHandle(watched);
+    m_windows << watched;
+
+    window->installEventFilter(this);
+    connect(window, &QObject::destroyed, this, &AnimationGovernor::evaluate, Qt::QueuedConnection);
+
+    evaluate();
+}
+
+void AnimationGovernor::unwatch(QWidget *window)
+{
+    for (int i = m_windows.size() - 1; i >= 0; --i) {
+        const WatchedWindow &watched = m_windows.at(i);
+        if (watched.widget != window) {
+            continue;
+        }
+
+        window->removeEventFilter(this);
+        if (watched.handle) {
+            watched.handle->removeEventFilter(this);
+        }
+        m_windows.removeAt(i);
+    }
+    evaluate();
+}
+
+void AnimationGovernor::registerTimer(QTimer *timer)
+{
+    if (!timer || m_timers.contains(timer)) {
+        return;
+    }
+
+    m_timers << timer;
+
+    // QTimer 启动时没有信号，挂起期间被重新启动的定时器在第一次触发时拦下
+    timer->installEventFilter(this);
+    if (m_isSuspended && timer->isActive()) {
+        timer->stop();
+        m_stoppedTimers << timer;
+    }
+}
+
+void AnimationGovernor::registerAnimation(QAbstractAnimation *animation)
+{
+    m_animations.removeAll(QPointer<QAbstractAnimation>());
+    if (!animation || m_animations.contains(animation)) {
+        return;
+    }
+
+    m_animations << animation;
+
+    // 挂起期间才启动的动画在进入运行状态时立即暂停，恢复时一并继续
+    connect(animation, &QAbstractAnimation::stateChanged, this,
+            [this, animation](QAbstractAnimation::State newState) {
+        if (m_isSuspended && newState == QAbstractAnimation::Running) {
+            pauseAnimation(animation);
+        }
+    });
+    if (m_isSuspended && animation->state() == QAbstractAnimation::Running) {
+        pauseAnimation(animation);
+    }
+}
+
+void AnimationGovernor::pauseAnimation(QAbstractAnimation *animation)
+{
+    animation->pause();
+    if (!m_pausedAnimations.contains(animation)) {
+        m_pausedAnimations << animation;
+    }
+}
+
+void AnimationGovernor::registerLibraryAnimations()
+{
+    // 库中这些控件的动画只负责装饰，不驱动任何流程：不确定进度环和进度条的循环动画
+    // （Loading 的转圈也由其中的 IndeterminateProgressRing 提供），以及 CardWidget 等
+    // 控件的悬停背景色过渡。控件随页面按需创建，每次挂起前重新查找一遍
+    for (const WatchedWindow &watched : m_windows) {
+        if (!watched.widget) {
+            continue;
+        }
+
+        const QList<QWidget *> widgets = watched.widget->findChildren<QWidget *>();
+        for (QWidget *widget : widgets) {
+            if (!qobject_cast<IndeterminateProgressRing *>(widget)
+                    && !qobject_cast<IndeterminateProgressBar *>(widget)
+                    && !qobject_cast<BackgroundAnimationWidget *>(widget)) {
+                continue;
+            }
+
+            const QList<QAbstractAnimation *> animations =
+                    widget->findChildren<QAbstractAnimation *>(QString(), Qt::FindDirectChildrenOnly);
+            for (QAbstractAnimation *animation : animations) {
+                if (!animation->group()) {
+                    registerAnimation(animation);
+                }
+            }
+        }
+    }
+}
+
+void AnimationGovernor::setDebugCountersEnabled(bool isEnabled)
+{
+    if (isEnabled == (m_debugTimer != nullptr)) {
+        return;
+    }
+
+    if (isEnabled) {
+        // 应用级过滤器只用于统计定时器事件，调试结束后移除
+        m_timerEvents = 0;
+        m_debugTimer = new QTimer(this);
+        m_debugTimer->setInterval(kDebugInterval);
+        connect(m_debugTimer, &QTimer::timeout, this, &AnimationGovernor::reportDebugCounters);
+        QCoreApplication::instance()->installEventFilter(this);
+        m_debugTimer->start();
+    } else {
+        QCoreApplication::instance()->removeEventFilter(this);
+        delete m_debugTimer;
+        m_debugTimer = nullptr;
+        m_timerWakeupsPerSecond = 0;
+    }
+}
+
+int AnimationGovernor::activeAnimationCount() const
+{
+    int count = AnimationClock::instance()->activeCount();
+    for (const WatchedWindow &watched : m_windows) {
+        if (!watched.widget) {
+            continue;
+        }
+
+        const QList<QAbstractAnimation *> animations = watched.widget->findChildren<QAbstractAnimation *>();
+        for (QAbstractAnimation *animation : animations) {
+            if (!animation->group() && animation->state() == QAbstractAnimation::Running) {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+bool AnimationGovernor::eventFilter(QObject *obj, QEvent *e)
+{
+    if (m_debugTimer && e->type() == QEvent::Timer) {
+        ++m_timerEvents;
+    }
+
+    if (m_isSuspended && e->type() == QEvent::Timer) {
+        auto timer = qobject_cast<QTimer *>(obj);
+        if (timer && m_timers.contains(timer)) {
+            timer->stop();
+            if (!m_stoppedTimers.contains(timer)) {
+                m_stoppedTimers << timer;
+            }
+            return true;
+        }
+    }
+
+    switch (e->type()) {
+    case QEvent::Show:
+    case QEvent::Hide:
+    case QEvent::WindowStateChange:
+    case QEvent::Expose:
+        for (WatchedWindow &watched : m_windows) {
+            if (watched.widget == obj || watched.handle == obj) {
+                // 原生窗口在第一次显示时才创建，此时补上曝光事件的监视
+                attachHandle(watched);
+                evaluate();
+                break;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+
+    return QObject::eventFilter(obj, e);
+}
+
+void AnimationGovernor::attachHandle(WatchedWindow &window)
+{
+    if (window.handle || !window.widget || !window.widget->windowHandle()) {
+        return;
+    }
+
+    window.handle = window.widget->windowHandle();
+    window.handle->installEventFilter(this);
+}
+
+bool AnimationGovernor::isAnyWindowVisible() const
+{
+    for (const WatchedWindow &watched : m_windows) {
+        if (!watched.widget || !watched.widget->isVisible() || watched.widget->isMinimized()) {
+            continue;
+        }
+
+        // 被完全遮挡或处于其他虚拟桌面时，平台会发送未曝光的 Expose 事件
+        if (watched.handle && !watched.handle->isExposed()) {
+            continue;
+        }
+        return true;
+    }
+    return false;
+}
+
+void AnimationGovernor::evaluate()
+{
+    for (int i = m_windows.size() - 1; i >= 0; --i) {
+        if (!m_windows.at(i).widget) {
+            m_windows.removeAt(i);
+        }
+    }
+
+    const bool shouldSuspend = !m_windows.isEmpty() && !isAnyWindowVisible();
+    if (shouldSuspend && !m_isSuspended) {
+        suspend();
+    } else if (!shouldSuspend && m_isSuspended) {
+        resume();
+    }
+}
+
+void AnimationGovernor::suspend()
+{
+    registerLibraryAnimations();
+
+    m_isSuspended = true;
+    AnimationClock::instance()->setPaused(true);
+
+    // 只暂停登记的动画：其余动画可能驱动着关闭、切换等流程，暂停会让它们停在半途
+    for (const QPointer<QAbstractAnimation> &animation : m_animations) {
+        if (animation && animation->state() == QAbstractAnimation::Running) {
+            pauseAnimation(animation);
+        }
+    }
+
+    for (const QPointer<QTimer> &timer : m_timers) {
+        if (timer && timer->isActive()) {
+            timer->stop();
+            m_stoppedTimers << timer;
+        }
+    }
+
+    emit suspendedChanged(true);
+}
+
+void AnimationGovernor::resume()
+{
+    m_isSuspended = false;
+    AnimationClock::instance()->setPaused(false);
+
+    for (const QPointer<QAbstractAnimation> &animation : m_pausedAnimations) {
+        if (animation && animation->state() == QAbstractAnimation::Paused) {
+            animation->resume();
+        }
+    }
+    m_pausedAnimations.clear();
+
+    for (const QPointer<QTimer> &timer : m_stoppedTimers) {
+        if (timer) {
+            timer->start();
+        }
+    }
+    m_stoppedTimers.clear();
+
+    emit suspendedChanged(false);
+}
+
+void AnimationGovernor::reportDebugCounters()
+{
+    // 不计调试定时器自身的唤醒
+    m_timerWakeupsPerSecond = qMax(0, m_timerEvents - 1);
+    m_timerEvents = 0;
+
+    emit debugCountersChanged(activeAnimationCount(), m_timerWakeupsPerSecond);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+
+class QTimer;
+class QWidget;
+class QWindow;
+class QAbstractAnimation;
+
+/**
+ * @brief 全局动画调度：窗口不可见时暂停装饰性动画
+ *
+ * 监视登记窗口的最小化、隐藏和曝光状态。所有登记窗口都不可见时，
+ * 暂停 AnimationClock 以及显式登记的装饰性动画和定时器（转圈进度环、循环的装饰效果等）；
+ * 任一窗口重新曝光时恢复。库中的 IndeterminateProgressRing / IndeterminateProgressBar
+ * （包括 Loading 中的转圈）以及 CardWidget 等控件的悬停背景动画在挂起前自动登记。
+ * 挂起期间才启动的登记动画和定时器同样会被暂停。未登记的动画不受影响，
+ * 依赖动画完成信号的流程不会被挂起。
+ *
+ * 调试计数开启后，每秒统计一次活动动画数和定时器唤醒次数并发出 debugCountersChanged。
+ */
+class AnimationGovernor : public QObject
+{
+    Q_OBJECT
+
+public:
+    static AnimationGovernor *instance();
+
+    /**
+     * @brief 登记需要监视的顶层窗口
+     */
+    void watch(QWidget *window);
+    void unwatch(QWidget *window);
+
+    /**
+     * @brief 登记装饰性定时器，窗口不可见时停止，恢复时以原间隔重新启动
+     */
+    void registerTimer(QTimer *timer);
+
+    /**
+     * @brief 登记装饰性动画（最外层动画或动画组），窗口不可见时暂停，恢复时继续
+     */
+    void registerAnimation(QAbstractAnimation *animation);
+
+    bool isSuspended() const { return m_isSuspended; }
+
+    void setDebugCountersEnabled(bool isEnabled);
+    bool isDebugCountersEnabled() const { return m_debugTimer != nullptr; }
+
+    /**
+     * @brief 当前运行中的动画数（时钟补间 + 登记窗口下运行中的 QAbstractAnimation）
+     */
+    int activeAnimationCount() const;
+
+    /**
+     * @brief 最近一秒内的定时器唤醒次数（需开启调试计数）
+     */
+    int timerWakeupsPerSecond() const { return m_timerWakeupsPerSecond; }
+
+signals:
+    void suspendedChanged(bool isSuspended);
+    void debugCountersChanged(int activeAnimations, int timerWakeupsPerSecond);
+
+protected:
+    bool eventFilter(QObject *obj, QEvent *e) override;
+
+private:
+    struct WatchedWindow {
+        QPointer<QWidget> widget;
+        QPointer<QWindow> handle;
+    };
+
+    explicit AnimationGovernor(QObject *parent = nullptr);
+
+    void attachHandle(WatchedWindow &window);
+    void registerLibraryAnimations();
+    void pauseAnimation(QAbstractAnimation *animation);
+    bool isAnyWindowVisible() const;
+    void evaluate();
+    void suspend();
+    void resume();
+    void reportDebugCounters();
+
+    QList<WatchedWindow> m_windows;
+    QList<QPointer<QTimer>> m_timers;
+    QList<QPointer<QAbstractAnimation>> m_animations;
+
+    bool m_isSuspended;
+    QList<QPointer<QAbstractAnimation>> m_pausedAnimations;
+    QList<QPointer<QTimer>> m_stoppedTimers;
+
+    QTimer *m_debugTimer;
+    int m_timerEvents;
+    int m_timerWakeupsPerSecond;
+};
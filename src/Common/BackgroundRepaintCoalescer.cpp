@@ -0,0 +1,159 @@
+#include "BackgroundRepaintCoalescer.h"
+
+#include <QTimer>
+#include <QWidget>
+#include <QCoreApplication>
+#include <QPropertyAnimation>
+
+#include "FluentTween.h"
+
+namespace {
+const QByteArray kBackgroundColorProperty = QByteArrayLiteral("backgroundColor");
+}
+
+BackgroundRepaintCoalescer *BackgroundRepaintCoalescer::instance()
+{
+    static BackgroundRepaintCoalescer *coalescer = new BackgroundRepaintCoalescer(QCoreApplication::instance());
+    return coalescer;
+}
+
+BackgroundRepaintCoalescer::BackgroundRepaintCoalescer(QObject *parent)
+    : QObject(parent)
+    , m_frameTimer(new QTimer(this))
+    , m_cancelledCount(0)
+{
+    m_frameTimer->setSingleShot(true);
+    m_frameTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_frameTimer, &QTimer::timeout, this, &BackgroundRepaintCoalescer::flush);
+}
+
+bool BackgroundRepaintCoalescer::attach(QWidget *widget)
+{
+    if (!widget) {
+        return false;
+    }
+    if (m_bindings.contains(widget)) {
+        return true;
+    }
+
+    // 背景色动画的目标是控件自身或其私有的颜色对象，排除子控件各自的动画
+    QPropertyAnimation *animation = nullptr;
+    const QList<QPropertyAnimation *> animations = widget->findChildren<QPropertyAnimation *>();
+    for (QPropertyAnimation *candidate : animations) {
+        QObject *target = candidate->targetObject();
+        if (candidate->propertyName() != kBackgroundColorProperty || !target) {
+            continue;
+        }
+        if (target == widget || (target->parent() == widget && !target->isWidgetType())) {
+            animation = candidate;
+            break;
+        }
+    }
+
+    if (!animation) {
+        return false;
+    }
+
+    Binding binding;
+    binding.animation = animation;
+    binding.connection = connect(animation, &QAbstractAnimation::stateChanged, this,
+                                 [this, widget, animation](QAbstractAnimation::State newState) {
+        if (newState == QAbstractAnimation::Running) {
+            intercept(widget, animation);
+        }
+    }, Qt::DirectConnection);
+    m_bindings.insert(widget, binding);
+
+    connect(widget, &QObject::destroyed, this, [this, widget]() {
+        m_bindings.remove(widget);
+        m_pending.remove(widget);
+    });
+    return true;
+}
+
+void BackgroundRepaintCoalescer::detach(QWidget *widget)
+{
+    auto it = m_bindings.find(widget);
+    if (it == m_bindings.end()) {
+        return;
+    }
+
+    disconnect(it->connection);
+    AnimationClock::instance()->stop(it->tweenId, true);
+    m_bindings.erase(it);
+    m_pending.remove(widget);
+}
+
+void BackgroundRepaintCoalescer::intercept(QWidget *widget, QPropertyAnimation *animation)
+{
+    Pending &pending = m_pending[widget];
+    pending.widget = widget;
+    pending.target = animation->endValue().value<QColor>();
+    pending.duration = animation->duration();
+    pending.curve = animation->easingCurve();
+
+    // 在 stateChanged 中停止，库内动画尚未写入起始值，也不会登记到动画定时器
+    animation->stop();
+
+    if (!m_frameTimer->isActive()) {
+        m_frameTimer->start(AnimationClock::instance()->frameInterval());
+    }
+}
+
+void BackgroundRepaintCoalescer::flush()
+{
+    const QHash<QWidget *, Pending> pending = m_pending;
+    m_pending.clear();
+    m_cancelledCount = 0;
+
+    AnimationClock *clock = AnimationClock::instance();
+    for (auto it = pending.constBegin(); it != pending.constEnd(); ++it) {
+        QWidget *widget = it.key();
+        const Pending &request = it.value();
+
+        auto binding = m_bindings.find(widget);
+        if (!request.widget || binding == m_bindings.end() || !binding->animation) {
+            continue;
+        }
+
+        // 正在运行的补间已写入当前颜色，直接从当前值重新开始
+        clock->stop(binding->tweenId);
+        binding->tweenId = 0;
+
+        QPointer<QPropertyAnimation> animation = binding->animation;
+        const QColor from = currentColor(animation);
+        const QColor to = request.target;
+        if (from == to) {
+            ++m_cancelledCount;
+            continue;
+        }
+
+        AnimationClock::Spec spec;
+        spec.duration = request.duration;
+        spec.curve = request.curve;
+
+        binding->tweenId = clock->start(0, 1, spec, [animation, from, to](qreal progress) {
+            if (animation) {
+                writeColor(animation, Tween::interpolate(from, to, progress));
+            }
+        }, widget, widget, [this, widget]() {
+            auto it = m_bindings.find(widget);
+            if (it != m_bindings.end()) {
+                it->tweenId = 0;
+            }
+        });
+    }
+}
+
+QColor BackgroundRepaintCoalescer::currentColor(const QPropertyAnimation *animation)
+{
+    QObject *target = animation->targetObject();
+    return target ? target->property(animation->propertyName()).value<QColor>() : QColor();
+}
+
+void BackgroundRepaintCoalescer::writeColor(QPropertyAnimation *animation, const QColor &color)
+{
+    if (QObject *target = animation->targetObject()) {
+        target->setProperty(animation->propertyName(), color);
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QHash>
+#include <QColor>
+#include <QObject>
+#include <QPointer>
+#include <QEasingCurve>
+
+#include "AnimationClock.h"
+
+class QTimer;
+class QWidget;
+class QPropertyAnimation;
+
+/**
+ * @brief 背景色动画合并
+ *
+ * 接管 BackgroundAnimationWidget（CardWidget、SampleCard 等）内部的背景色动画：
+ * 库内动画每次启动时立即被取消，目标颜色记入待处理表，到下一帧统一处理。
+ * 同一帧内先进入再离开等来回切换的请求，若目标已等于当前颜色则直接丢弃；
+ * 其余请求改由 AnimationClock 推进，同一窗口下所有卡片的重绘区域每帧合并为一次 update。
+ *
+ * 控件中找不到背景色动画时保持库的原有行为。
+ */
+class BackgroundRepaintCoalescer : public QObject
+{
+    Q_OBJECT
+
+public:
+    static BackgroundRepaintCoalescer *instance();
+
+    /**
+     * @brief 接管 widget 的背景色动画，应在控件构造完成后调用
+     * @return 是否找到并接管了背景色动画
+     */
+    bool attach(QWidget *widget);
+    void detach(QWidget *widget);
+
+    /**
+     * @brief 上一次合并中被直接丢弃的请求数，用于调试
+     */
+    int cancelledCount() const { return m_cancelledCount; }
+
+private:
+    struct Binding {
+        QPointer<QPropertyAnimation> animation;
+        QMetaObject::Connection connection;
+        AnimationClock::TweenId tweenId = 0;
+    };
+
+    struct Pending {
+        QPointer<QWidget> widget;
+        QColor target;
+        int duration = 120;
+        QEasingCurve curve;
+    };
+
+    explicit BackgroundRepaintCoalescer(QObject *parent = nullptr);
+
+    void intercept(QWidget *widget, QPropertyAnimation *animation);
+    void flush();
+    static QColor currentColor(const QPropertyAnimation *animation);
+    static void writeColor(QPropertyAnimation *animation, const QColor &color);
+
+    QHash<QWidget *, Binding> m_bindings;
+    QHash<QWidget *, Pending> m_pending;
+    QTimer *m_frameTimer;
+    int m_cancelledCount;
+};
@@ -0,0 +1,351 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <functional>
+#include <type_traits>
+
+#include <QHash>
+#include <QRect>
+#include <QSize>
+#include <QColor>
+#include <QPoint>
+#include <QtMath>
+#include <QObject>
+#include <QWidget>
+#include <QPointer>
+#include <QEasingCurve>
+
+#include "AnimationClock.h"
+
+/**
+ * @brief 缓动曲线查找表
+ *
+ * 在 [0, 1] 上均匀采样 256 段，运行时线性插值，推进时不再调用 QEasingCurve。
+ */
+class EasingTable
+{
+public:
+    static constexpr int kSegments = 256;
+
+    qreal valueAt(qreal progress) const
+    {
+        if (progress <= 0) {
+            return m_samples[0];
+        }
+        if (progress >= 1) {
+            return m_samples[kSegments];
+        }
+
+        const qreal position = progress * kSegments;
+        const int index = int(position);
+        const qreal fraction = position - index;
+        return m_samples[index] + (m_samples[index + 1] - m_samples[index]) * fraction;
+    }
+
+    static std::shared_ptr<const EasingTable> fromCurve(const QEasingCurve &curve)
+    {
+        auto table = std::make_shared<EasingTable>();
+        for (int i = 0; i <= kSegments; ++i) {
+            table->m_samples[i] = float(curve.valueForProgress(qreal(i) / kSegments));
+        }
+        return table;
+    }
+
+    /**
+     * @brief 与 FluentAnimation::createBezierCurve(x1, y1, x2, y2) 相同的三次贝塞尔曲线
+     */
+    static std::shared_ptr<const EasingTable> fromBezier(qreal x1, qreal y1, qreal x2, qreal y2)
+    {
+        auto table = std::make_shared<EasingTable>();
+        for (int i = 0; i <= kSegments; ++i) {
+            table->m_samples[i] = float(solveBezier(x1, y1, x2, y2, qreal(i) / kSegments));
+        }
+        return table;
+    }
+
+    /**
+     * @brief FluentAnimation::create 对应类型和速度的曲线，按类型缓存
+     */
+    static std::shared_ptr<const EasingTable> forType(FluentAnimationType type, FluentAnimationSpeed speed)
+    {
+        static QHash<int, std::shared_ptr<const EasingTable>> tables;
+
+        const int key = int(type) * 4 + int(speed);
+        auto it = tables.constFind(key);
+        if (it != tables.constEnd()) {
+            return it.value();
+        }
+        return *tables.insert(key, fromCurve(AnimationClock::specFor(type, speed).curve));
+    }
+
+    static std::shared_ptr<const EasingTable> linear()
+    {
+        static const std::shared_ptr<const EasingTable> table = fromCurve(QEasingCurve::Linear);
+        return table;
+    }
+
+private:
+    // 起点 (0, 0)、终点 (1, 1) 的三次贝塞尔，先由 x 反解参数 t 再求 y
+    static qreal solveBezier(qreal x1, qreal y1, qreal x2, qreal y2, qreal x)
+    {
+        const auto sample = [](qreal p1, qreal p2, qreal t) {
+            const qreal u = 1 - t;
+            return 3 * u * u * t * p1 + 3 * u * t * t * p2 + t * t * t;
+        };
+        const auto slope = [](qreal p1, qreal p2, qreal t) {
+            const qreal u = 1 - t;
+            return 3 * u * u * p1 + 6 * u * t * (p2 - p1) + 3 * t * t * (1 - p2);
+        };
+
+        // 牛顿迭代，斜率过小时退回二分
+        qreal t = x;
+        for (int i = 0; i < 8; ++i) {
+            const qreal error = sample(x1, x2, t) - x;
+            const qreal d = slope(x1, x2, t);
+            if (qAbs(error) < 1e-6) {
+                return sample(y1, y2, t);
+            }
+            if (qAbs(d) < 1e-6) {
+                break;
+            }
+            t -= error / d;
+        }
+
+        qreal low = 0;
+        qreal high = 1;
+        t = x;
+        for (int i = 0; i < 32; ++i) {
+            const qreal value = sample(x1, x2, t);
+            if (qAbs(value - x) < 1e-6) {
+                break;
+            }
+            if (value < x) {
+                low = t;
+            } else {
+                high = t;
+            }
+            t = (low + high) / 2;
+        }
+        return sample(y1, y2, t);
+    }
+
+    std::array<float, kSegments + 1> m_samples;
+};
+
+/**
+ * @brief 各类型的线性插值
+ */
+namespace Tween {
+
+inline float interpolate(float from, float to, qreal progress)
+{
+    return float(from + (to - from) * progress);
+}
+
+inline qreal interpolate(qreal from, qreal to, qreal progress)
+{
+    return from + (to - from) * progress;
+}
+
+inline int interpolate(int from, int to, qreal progress)
+{
+    return qRound(from + (to - from) * progress);
+}
+
+inline QPointF interpolate(const QPointF &from, const QPointF &to, qreal progress)
+{
+    return from + (to - from) * progress;
+}
+
+inline QPoint interpolate(const QPoint &from, const QPoint &to, qreal progress)
+{
+    return QPoint(interpolate(from.x(), to.x(), progress), interpolate(from.y(), to.y(), progress));
+}
+
+inline QSizeF interpolate(const QSizeF &from, const QSizeF &to, qreal progress)
+{
+    return from + (to - from) * progress;
+}
+
+inline QSize interpolate(const QSize &from, const QSize &to, qreal progress)
+{
+    return QSize(interpolate(from.width(), to.width(), progress), interpolate(from.height(), to.height(), progress));
+}
+
+inline QRectF interpolate(const QRectF &from, const QRectF &to, qreal progress)
+{
+    return QRectF(interpolate(from.topLeft(), to.topLeft(), progress), interpolate(from.size(), to.size(), progress));
+}
+
+inline QRect interpolate(const QRect &from, const QRect &to, qreal progress)
+{
+    return QRect(interpolate(from.topLeft(), to.topLeft(), progress), interpolate(from.size(), to.size(), progress));
+}
+
+inline QColor interpolate(const QColor &from, const QColor &to, qreal progress)
+{
+    return QColor::fromRgbF(interpolate(from.redF(), to.redF(), progress),
+                            interpolate(from.greenF(), to.greenF(), progress),
+                            interpolate(from.blueF(), to.blueF(), progress),
+                            interpolate(from.alphaF(), to.alphaF(), progress));
+}
+
+}
+
+/**
+ * @brief 类型化补间
+ *
+ * 数值经 Tween::interpolate 插值后直接写入成员变量或回调，不经过 QVariant 与属性系统；
+ * 缓动取自预先采样的 EasingTable，推进由 AnimationClock 统一驱动。
+ * 对象析构时自动停止。
+ *
+ * @code
+ * FluentTween<qreal> tween(this, &Widget::m_opacity, this);
+ * tween.setFluentSpec(FluentAnimationType::FAST_INVOKE);
+ * tween.start(0, 1);
+ * @endcode
+ */
+template <typename T>
+class FluentTween
+{
+public:
+    using Setter = std::function<void(const T &)>;
+
+    FluentTween()
+        : m_state(std::make_shared<State>())
+    {
+    }
+
+    explicit FluentTween(Setter setter, QWidget *repaintTarget = nullptr, QObject *context = nullptr)
+        : FluentTween()
+    {
+        m_state->setter = std::move(setter);
+        m_repaintTarget = repaintTarget;
+        m_context = context;
+    }
+
+    /**
+     * @brief 直接写入 object 的成员变量；object 为 QObject 时同时作为生命周期对象
+     */
+    template <typename Object>
+    FluentTween(Object *object, T Object::*member, QWidget *repaintTarget = nullptr)
+        : FluentTween([object, member](const T &value) { object->*member = value; },
+                      repaintTarget, contextOf(object))
+    {
+    }
+
+    ~FluentTween()
+    {
+        stop();
+    }
+
+    FluentTween(const FluentTween &) = delete;
+    FluentTween &operator=(const FluentTween &) = delete;
+
+    /**
+     * @brief 按 FluentAnimation::create 的同名类型设置时长和缓动
+     */
+    static std::unique_ptr<FluentTween> create(FluentAnimationType type,
+                                               FluentAnimationSpeed speed,
+                                               Setter setter,
+                                               QWidget *repaintTarget = nullptr,
+                                               QObject *context = nullptr)
+    {
+        std::unique_ptr<FluentTween> tween(new FluentTween(std::move(setter), repaintTarget, context));
+        tween->setFluentSpec(type, speed);
+        return tween;
+    }
+
+    void setFluentSpec(FluentAnimationType type, FluentAnimationSpeed speed = FluentAnimationSpeed::FAST)
+    {
+        m_duration = AnimationClock::specFor(type, speed).duration;
+        m_easing = EasingTable::forType(type, speed);
+    }
+
+    void setDuration(int msec) { m_duration = qMax(1, msec); }
+    int duration() const { return m_duration; }
+
+    void setEasing(const QEasingCurve &curve) { m_easing = EasingTable::fromCurve(curve); }
+    void setEasing(std::shared_ptr<const EasingTable> table) { m_easing = std::move(table); }
+
+    void setSetter(Setter setter) { m_state->setter = std::move(setter); }
+
+    /**
+     * @brief 从 from 过渡到 to，正在运行的补间会先被停止
+     */
+    void start(const T &from, const T &to)
+    {
+        stop();
+
+        m_state->from = from;
+        m_state->to = to;
+        m_state->current = from;
+
+        // 时钟不经过缓动曲线，只推进线性进度，缓动和插值都在这里完成；没有设置缓动时直接线性插值
+        std::shared_ptr<State> state = m_state;
+        std::shared_ptr<const EasingTable> easing = m_easing;
+
+        AnimationClock::Spec spec;
+        spec.duration = m_duration;
+        spec.hasCurve = false;
+
+        m_id = AnimationClock::instance()->start(0, 1, spec, [state, easing](qreal progress) {
+            state->current = Tween::interpolate(state->from, state->to, easing ? easing->valueAt(progress) : progress);
+            if (state->setter) {
+                state->setter(state->current);
+            }
+        }, m_repaintTarget, m_context);
+    }
+
+    /**
+     * @brief 从当前值过渡到 to
+     */
+    void startTo(const T &to)
+    {
+        start(m_state->current, to);
+    }
+
+    void stop(bool jumpToEnd = false)
+    {
+        if (m_id != 0) {
+            AnimationClock::instance()->stop(m_id, jumpToEnd);
+            m_id = 0;
+        }
+    }
+
+    bool isRunning() const
+    {
+        return m_id != 0 && AnimationClock::instance()->isRunning(m_id);
+    }
+
+    T currentValue() const { return m_state->current; }
+    T endValue() const { return m_state->to; }
+
+private:
+    struct State {
+        T from = T();
+        T to = T();
+        T current = T();
+        Setter setter;
+    };
+
+    template <typename Object>
+    static QObject *contextOf(Object *object, typename std::enable_if<std::is_base_of<QObject, Object>::value>::type * = nullptr)
+    {
+        return object;
+    }
+
+    template <typename Object>
+    static QObject *contextOf(Object *, typename std::enable_if<!std::is_base_of<QObject, Object>::value>::type * = nullptr)
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<State> m_state;
+    std::shared_ptr<const EasingTable> m_easing;
+    int m_duration = 250;
+    QPointer<QWidget> m_repaintTarget;
+    QPointer<QObject> m_context;
+    AnimationClock::TweenId m_id = 0;
+};
@@ -0,0 +1,385 @@
+#include "NinePatchShadow.h"
+
+#include <QEvent>
+#include <QImage>
+#include <QtMath>
+#include <QVector>
+#include <QPainter>
+#include <QEasingCurve>
+
+namespace {
+constexpr int kMaxCachedPatches = 64;
+constexpr int kBlurPasses = 3;
+
+// 一行（或一列）的盒式模糊，窗口外按 0 计
+void blurLine(uchar *data, int count, int step, int radius, QVector<uchar> &buffer)
+{
+    buffer.resize(count);
+    for (int i = 0; i < count; ++i) {
+        buffer[i] = data[i * step];
+    }
+
+    const int window = 2 * radius + 1;
+    int sum = 0;
+    for (int i = 0; i <= radius && i < count; ++i) {
+        sum += buffer[i];
+    }
+
+    for (int i = 0; i < count; ++i) {
+        data[i * step] = uchar(sum / window);
+
+        const int incoming = i + radius + 1;
+        const int outgoing = i - radius;
+        if (incoming < count) {
+            sum += buffer[incoming];
+        }
+        if (outgoing >= 0) {
+            sum -= buffer[outgoing];
+        }
+    }
+}
+
+// 三次盒式模糊近似高斯模糊
+void gaussianBlur(QImage &image, qreal sigma)
+{
+    const int radius = qMax(1, qRound(sigma));
+    const int width = image.width();
+    const int height = image.height();
+    const int stride = image.bytesPerLine();
+    uchar *bits = image.bits();
+
+    QVector<uchar> buffer;
+    for (int pass = 0; pass < kBlurPasses; ++pass) {
+        for (int y = 0; y < height; ++y) {
+            blurLine(bits + y * stride, width, 1, radius, buffer);
+        }
+        for (int x = 0; x < width; ++x) {
+            blurLine(bits + x, height, stride, radius, buffer);
+        }
+    }
+}
+
+QHash<quint64, QPixmap> &patchCache()
+{
+    static QHash<quint64, QPixmap> cache;
+    return cache;
+}
+}
+
+int ShadowRenderer::extent(int blurRadius)
+{
+    // 每次盒式模糊的半径约为 blur / 2，三次叠加后向外扩散 1.5 倍 blur，另留取整的余量
+    return blurRadius > 0 ? qCeil(kBlurPasses * blurRadius / 2.0) + 2 : 0;
+}
+
+void ShadowRenderer::drawShadow(QPainter *painter, const QRect &rect, int borderRadius,
+                                int blurRadius, const QColor &color)
+{
+    if (color.alpha() == 0 || rect.isEmpty()) {
+        return;
+    }
+
+    const qreal dpr = painter->device()->devicePixelRatioF();
+    const QPixmap pixmap = ninePatch(borderRadius, blurRadius, color, dpr);
+
+    // 四角的逻辑尺寸为 radius + 2 * extent，目标矩形外扩 extent；
+    // 矩形小于两个角时两侧各取一半，角被压缩而不是互相覆盖
+    const int e = extent(blurRadius);
+    const int c = borderRadius + 2 * e;
+    const QRect r = rect.adjusted(-e, -e, e, e);
+
+    const int left = qMin(c, r.width() / 2);
+    const int right = qMin(c, r.width() - left);
+    const int top = qMin(c, r.height() / 2);
+    const int bottom = qMin(c, r.height() - top);
+    const int middleWidth = r.width() - left - right;
+    const int middleHeight = r.height() - top - bottom;
+
+    const qreal sc = c * dpr;
+    const qreal sm = dpr;
+
+    const int xs[3] = {r.left(), r.left() + left, r.left() + left + middleWidth};
+    const int ys[3] = {r.top(), r.top() + top, r.top() + top + middleHeight};
+    const int ws[3] = {left, middleWidth, right};
+    const int hs[3] = {top, middleHeight, bottom};
+    const qreal sxs[3] = {0, sc, sc + sm};
+    const qreal sws[3] = {sc, sm, sc};
+
+    painter->save();
+    painter->setOpacity(painter->opacity() * color.alphaF());
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            if (ws[column] <= 0 || hs[row] <= 0) {
+                continue;
+            }
+            painter->drawPixmap(QRectF(xs[column], ys[row], ws[column], hs[row]), pixmap,
+                                QRectF(sxs[column], sxs[row], sws[column], sws[row]));
+        }
+    }
+    painter->restore();
+}
+
+QPixmap ShadowRenderer::ninePatch(int borderRadius, int blurRadius, const QColor &color, qreal dpr)
+{
+    // 透明度不进入缓存键，只在绘制时混合
+    const quint64 key = (quint64(color.rgb() & 0xFFFFFF) << 36)
+                        | (quint64(qRound(dpr * 100) & 0xFFF) << 24)
+                        | (quint64(qBound(0, blurRadius, 0xFFF)) << 12)
+                        | quint64(qBound(0, borderRadius, 0xFFF));
+
+    QHash<quint64, QPixmap> &cache = patchCache();
+    auto it = cache.constFind(key);
+    if (it != cache.constEnd()) {
+        return it.value();
+    }
+
+    const QImage mask = renderMask(borderRadius, blurRadius, dpr);
+
+    QPixmap pixmap(mask.size());
+    pixmap.setDevicePixelRatio(dpr);
+    pixmap.fill(Qt::transparent);
+    {
+        QPainter painter(&pixmap);
+        painter.fillRect(QRectF(QPointF(0, 0), QSizeF(mask.size()) / dpr), QColor(color.rgb()));
+        painter.setCompositionMode(QPainter::CompositionMode_DestinationIn);
+        painter.drawImage(0, 0, mask);
+    }
+
+    if (cache.size() >= kMaxCachedPatches) {
+        cache.clear();
+    }
+    cache.insert(key, pixmap);
+    return pixmap;
+}
+
+void ShadowRenderer::clearCache()
+{
+    patchCache().clear();
+}
+
+QImage ShadowRenderer::renderMask(int borderRadius, int blurRadius, qreal dpr)
+{
+    // 模糊向外扩散 e：图像四周各留 e，尾部不被图像边界截断；
+    // 轮廓的半边长为 radius + e，中心 1 像素距轮廓的直边和圆角都至少 e，模糊后完全不透明，
+    // 拉伸用的中心行列取自这片平台
+    const int e = extent(blurRadius);
+    const int c = borderRadius + 2 * e;
+    const int size = 2 * c + 1;
+    const int pixels = qCeil(size * dpr);
+
+    QImage mask(pixels, pixels, QImage::Format_Alpha8);
+    mask.fill(0);
+    {
+        QPainter painter(&mask);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(Qt::black);
+        painter.scale(dpr, dpr);
+        painter.drawRoundedRect(QRectF(e, e, size - 2 * e, size - 2 * e), borderRadius, borderRadius);
+    }
+
+    // 与 QGraphicsDropShadowEffect 的模糊半径大致对应：sigma 取半径的一半
+    if (blurRadius > 0) {
+        gaussianBlur(mask, blurRadius * dpr / 2.0);
+    }
+
+    mask.setDevicePixelRatio(dpr);
+    return mask;
+}
+
+NinePatchShadow::NinePatchShadow(QWidget *target)
+    : QWidget(target ? target->parentWidget() : nullptr)
+    , m_target(target)
+    , m_blurRadius(38)
+    , m_borderRadius(8)
+    , m_offset(0, 0)
+    , m_color(0, 0, 0, 0)
+    , m_shadowOpacity(1)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setAttribute(Qt::WA_NoSystemBackground);
+
+    if (m_target) {
+        m_target->installEventFilter(this);
+        // 阴影挂在目标的父控件上，目标单独销毁时阴影也随之释放
+        connect(m_target, &QObject::destroyed, this, &QObject::deleteLater);
+        updateGeometryFromTarget();
+        setVisible(parentWidget() && m_target->isVisible());
+    }
+}
+
+void NinePatchShadow::setBlurRadius(int radius)
+{
+    m_blurRadius = qMax(0, radius);
+    updateGeometryFromTarget();
+    update();
+}
+
+void NinePatchShadow::setBorderRadius(int radius)
+{
+    m_borderRadius = qMax(0, radius);
+    update();
+}
+
+void NinePatchShadow::setOffset(int dx, int dy)
+{
+    m_offset = QPoint(dx, dy);
+    updateGeometryFromTarget();
+}
+
+void NinePatchShadow::setColor(const QColor &color)
+{
+    if (m_color == color) {
+        return;
+    }
+
+    // 透明度不进入贴图缓存键，只有 RGB 变化时才会生成新贴图
+    m_color = color;
+    update();
+}
+
+void NinePatchShadow::setShadowOpacity(qreal opacity)
+{
+    opacity = qBound<qreal>(0, opacity, 1);
+    if (qFuzzyCompare(m_shadowOpacity, opacity)) {
+        return;
+    }
+
+    m_shadowOpacity = opacity;
+    update();
+}
+
+void NinePatchShadow::paintEvent(QPaintEvent *)
+{
+    if (m_color.alpha() == 0 || m_shadowOpacity <= 0) {
+        return;
+    }
+
+    const int e = ShadowRenderer::extent(m_blurRadius);
+    QPainter painter(this);
+    painter.setOpacity(m_shadowOpacity);
+    ShadowRenderer::drawShadow(&painter, rect().adjusted(e, e, -e, -e), m_borderRadius, m_blurRadius, m_color);
+}
+
+bool NinePatchShadow::eventFilter(QObject *obj, QEvent *e)
+{
+    if (obj == m_target) {
+        switch (e->type()) {
+        case QEvent::Move:
+        case QEvent::Resize:
+            updateGeometryFromTarget();
+            break;
+        case QEvent::Show:
+            updateGeometryFromTarget();
+            setVisible(parentWidget() != nullptr);
+            break;
+        case QEvent::Hide:
+            hide();
+            break;
+        case QEvent::ParentChange:
+            setParent(m_target->parentWidget());
+            updateGeometryFromTarget();
+            setVisible(parentWidget() && m_target->isVisible());
+            break;
+        case QEvent::ZOrderChange:
+            stackUnder(m_target);
+            break;
+        default:
+            break;
+        }
+    }
+    return QWidget::eventFilter(obj, e);
+}
+
+void NinePatchShadow::updateGeometryFromTarget()
+{
+    if (!m_target) {
+        return;
+    }
+
+    const int e = ShadowRenderer::extent(m_blurRadius);
+    setGeometry(m_target->geometry().translated(m_offset).adjusted(-e, -e, e, e));
+    stackUnder(m_target);
+}
+
+NinePatchShadowAnimation::NinePatchShadowAnimation(QWidget *target, const QColor &normalColor,
+                                                   const QColor &hoverColor)
+    : QPropertyAnimation(target)
+    , m_shadow(new NinePatchShadow(target))
+    , m_normalColor(normalColor)
+    , m_hoverColor(hoverColor)
+{
+    setTargetObject(m_shadow);
+    setPropertyName("shadowOpacity");
+    setDuration(150);
+    setEasingCurve(QEasingCurve::InOutQuad);
+
+    m_shadow->setColor(m_normalColor);
+    target->installEventFilter(this);
+}
+
+void NinePatchShadowAnimation::setBlurRadius(int radius)
+{
+    m_shadow->setBlurRadius(radius);
+}
+
+void NinePatchShadowAnimation::setBorderRadius(int radius)
+{
+    m_shadow->setBorderRadius(radius);
+}
+
+void NinePatchShadowAnimation::setOffset(int dx, int dy)
+{
+    m_shadow->setOffset(dx, dy);
+}
+
+void NinePatchShadowAnimation::setNormalColor(const QColor &color)
+{
+    m_normalColor = color;
+}
+
+void NinePatchShadowAnimation::setHoverColor(const QColor &color)
+{
+    m_hoverColor = color;
+}
+
+void NinePatchShadowAnimation::setColor(const QColor &color)
+{
+    stop();
+    m_shadow->setColor(color);
+    m_shadow->setShadowOpacity(1);
+}
+
+bool NinePatchShadowAnimation::eventFilter(QObject *obj, QEvent *e)
+{
+    if (obj == parent() && obj->isWidgetType()) {
+        if (e->type() == QEvent::Enter) {
+            animateTo(m_hoverColor);
+        } else if (e->type() == QEvent::Leave) {
+            animateTo(m_normalColor);
+        }
+    }
+    return QPropertyAnimation::eventFilter(obj, e);
+}
+
+void NinePatchShadowAnimation::animateTo(const QColor &color)
+{
+    stop();
+
+    // RGB 固定为目标颜色（目标全透明时沿用当前颜色），只补间不透明度：
+    // 颜色取起止两端中较大的透明度，起止不透明度按它换算
+    const int currentAlpha = qRound(m_shadow->color().alpha() * m_shadow->shadowOpacity());
+    const int baseAlpha = qMax(currentAlpha, color.alpha());
+    if (baseAlpha == 0) {
+        setColor(color);
+        return;
+    }
+
+    QColor base = color.alpha() > 0 ? color : m_shadow->color();
+    base.setAlpha(baseAlpha);
+    m_shadow->setColor(base);
+
+    setStartValue(qreal(currentAlpha) / baseAlpha);
+    setEndValue(qreal(color.alpha()) / baseAlpha);
+    start();
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <QHash>
+#include <QColor>
+#include <QPixmap>
+#include <QPointer>
+#include <QWidget>
+#include <QPropertyAnimation>
+
+/**
+ * @brief 九宫格阴影渲染
+ *
+ * 圆角矩形轮廓按 (圆角, 模糊半径, 颜色, 设备像素比) 模糊一次，得到最小尺寸的九宫格贴图，
+ * 任意大小的控件都由四角原样、四边和中心拉伸拼出阴影，与控件尺寸无关。
+ * 轮廓内部足够大，拉伸用的中心完全不透明，结果与直接模糊同尺寸的矩形一致。
+ * 贴图以不透明颜色生成，颜色的透明度在绘制时通过画笔不透明度混合，
+ * 透明度动画不会触发重新模糊。
+ */
+class ShadowRenderer
+{
+public:
+    /**
+     * @brief 绘制阴影
+     * @param rect 投下阴影的圆角矩形（不含模糊范围）
+     */
+    static void drawShadow(QPainter *painter, const QRect &rect, int borderRadius,
+                           int blurRadius, const QColor &color);
+
+    /**
+     * @brief 模糊后阴影超出矩形的距离，绘制区域需要在矩形四周各留出这么多
+     */
+    static int extent(int blurRadius);
+
+    static QPixmap ninePatch(int borderRadius, int blurRadius, const QColor &color, qreal dpr);
+
+    static void clearCache();
+
+private:
+    ShadowRenderer() = delete;
+
+    static QImage renderMask(int borderRadius, int blurRadius, qreal dpr);
+};
+
+/**
+ * @brief 绘制在目标控件下方的九宫格阴影
+ *
+ * 作为目标的兄弟控件叠放在其下方，跟随目标移动、缩放和显隐，代替
+ * QGraphicsDropShadowEffect：目标重绘时不再对整块渲染结果做模糊。
+ * 只适用于有父控件的目标，顶层窗口仍需使用窗口阴影。目标销毁时阴影随之释放。
+ */
+class NinePatchShadow : public QWidget
+{
+    Q_OBJECT
+    Q_PROPERTY(QColor color READ color WRITE setColor)
+    Q_PROPERTY(qreal shadowOpacity READ shadowOpacity WRITE setShadowOpacity)
+
+public:
+    explicit NinePatchShadow(QWidget *target);
+
+    QWidget *target() const { return m_target; }
+
+    void setBlurRadius(int radius);
+    int blurRadius() const { return m_blurRadius; }
+
+    void setBorderRadius(int radius);
+    int borderRadius() const { return m_borderRadius; }
+
+    void setOffset(int dx, int dy);
+    QPoint offset() const { return m_offset; }
+
+    void setColor(const QColor &color);
+    QColor color() const { return m_color; }
+
+    /**
+     * @brief 绘制时再乘上的不透明度，变化时不会重新生成贴图
+     */
+    void setShadowOpacity(qreal opacity);
+    qreal shadowOpacity() const { return m_shadowOpacity; }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    bool eventFilter(QObject *obj, QEvent *e) override;
+
+private:
+    void updateGeometryFromTarget();
+
+    QPointer<QWidget> m_target;
+    int m_blurRadius;
+    int m_borderRadius;
+    QPoint m_offset;
+    QColor m_color;
+    qreal m_shadowOpacity;
+};
+
+/**
+ * @brief 悬停阴影动画
+ *
+ * 接口与 DropShadowAnimation 一致，鼠标进入目标时阴影过渡到悬停色，离开时恢复。
+ * 动画开始时颜色的 RGB 就设为目标颜色，过程中只改变 NinePatchShadow 的绘制不透明度，
+ * 每次过渡最多生成一张贴图，每帧只是按新的不透明度重贴一次九宫格。
+ */
+class NinePatchShadowAnimation : public QPropertyAnimation
+{
+    Q_OBJECT
+
+public:
+    explicit NinePatchShadowAnimation(QWidget *target,
+                                      const QColor &normalColor = QColor(0, 0, 0, 0),
+                                      const QColor &hoverColor = QColor(0, 0, 0, 75));
+
+    NinePatchShadow *shadow() const { return m_shadow; }
+
+    void setBlurRadius(int radius);
+    void setBorderRadius(int radius);
+    void setOffset(int dx, int dy);
+    void setNormalColor(const QColor &color);
+    void setHoverColor(const QColor &color);
+    void setColor(const QColor &color);
+
+protected:
+    bool eventFilter(QObject *obj, QEvent *e) override;
+
+private:
+    void animateTo(const QColor &color);
+
+    NinePatchShadow *m_shadow;
+    QColor m_normalColor;
+    QColor m_hoverColor;
+};
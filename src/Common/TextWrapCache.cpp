@@ -0,0 +1,471 @@
+#include "TextWrapCache.h"
+
+#include <list>
+#include <array>
+#include <atomic>
+
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+#include <QStringList>
+#include <QFontMetrics>
+
+namespace {
+constexpr int kShardCount = 16;
+constexpr int kDefaultCacheSize = 1024;
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+using HashValue = size_t;
+#else
+using HashValue = uint;
+#endif
+
+enum CharClass : quint8 {
+    Latin,
+    Asian,
+    Space
+};
+
+// east_asian_width 为 W / F 的主要区段
+constexpr uint kWideRanges[][2] = {
+    {0x1100, 0x115F},    // 谚文字母
+    {0x2E80, 0x303E},    // 部首、康熙部首、CJK 符号和标点
+    {0x3041, 0x33FF},    // 假名、注音、兼容字符
+    {0x3400, 0x4DBF},    // 扩展 A
+    {0x4E00, 0x9FFF},    // 基本汉字
+    {0xA000, 0xA4CF},    // 彝文
+    {0xAC00, 0xD7A3},    // 谚文音节
+    {0xF900, 0xFAFF},    // 兼容汉字
+    {0xFE30, 0xFE4F},    // 竖排标点
+    {0xFF00, 0xFF60},    // 全角 ASCII
+    {0xFFE0, 0xFFE6},    // 全角符号
+    {0x1F300, 0x1F64F},  // 表情符号
+    {0x1F900, 0x1F9FF},
+    {0x20000, 0x3FFFD},  // 扩展 B 及以后
+};
+
+// 基本多文种平面逐码位的分类表，进程内只构建一次（局部静态变量的初始化是线程安全的）
+const std::array<quint8, 0x10000> &bmpTable()
+{
+    static const std::array<quint8, 0x10000> table = [] {
+        std::array<quint8, 0x10000> t;
+        t.fill(Latin);
+        for (const auto &range : kWideRanges) {
+            for (uint c = range[0]; c <= range[1] && c < 0x10000; ++c) {
+                t[c] = Asian;
+            }
+        }
+        for (uint c = 0; c < 0x10000; ++c) {
+            if (QChar::isSpace(c)) {
+                t[c] = Space;
+            }
+        }
+        return t;
+    }();
+    return table;
+}
+
+CharClass classify(uint ucs4)
+{
+    if (ucs4 < 0x10000) {
+        return CharClass(bmpTable()[ucs4]);
+    }
+    for (const auto &range : kWideRanges) {
+        if (ucs4 >= range[0] && ucs4 <= range[1]) {
+            return Asian;
+        }
+    }
+    return Latin;
+}
+
+int charWidth(CharClass type)
+{
+    return type == Asian ? 2 : 1;
+}
+
+// 读取 pos 处的码位，返回其占用的 UTF-16 单元数
+int readChar(const QString &text, int pos, uint *ucs4)
+{
+    const QChar c = text.at(pos);
+    if (c.isHighSurrogate() && pos + 1 < text.size() && text.at(pos + 1).isLowSurrogate()) {
+        *ucs4 = QChar::surrogateToUcs4(c, text.at(pos + 1));
+        return 2;
+    }
+    *ucs4 = c.unicode();
+    return 1;
+}
+
+int rangeWidth(const QString &text, int begin, int end)
+{
+    // ASCII 与 CJK 都直接查表，只有增补平面的字符才需要遍历区段
+    const std::array<quint8, 0x10000> &table = bmpTable();
+    int width = 0;
+    for (int pos = begin; pos < end;) {
+        const ushort u = text.at(pos).unicode();
+        if (u < 0x80) {
+            width += 1;
+            ++pos;
+        } else if (!QChar::isHighSurrogate(u)) {
+            width += table[u] == Asian ? 2 : 1;
+            ++pos;
+        } else {
+            uint ucs4 = 0;
+            pos += readChar(text, pos, &ucs4);
+            width += charWidth(classify(ucs4));
+        }
+    }
+    return width;
+}
+
+QString rstripped(const QString &text, int begin, int end)
+{
+    while (end > begin && text.at(end - 1).isSpace()) {
+        --end;
+    }
+    return text.mid(begin, end - begin);
+}
+
+struct Token {
+    int begin;
+    int end;
+    int width;
+    bool isSpace;
+};
+
+// 连续的拉丁字符合并为一个词，东亚字符和空白各自成词
+QVector<Token> tokenize(const QString &line)
+{
+    QVector<Token> tokens;
+    tokens.reserve(line.size());
+
+    CharClass lastType = Latin;
+    for (int pos = 0; pos < line.size();) {
+        uint ucs4 = 0;
+        const int length = readChar(line, pos, &ucs4);
+        const CharClass type = classify(ucs4);
+
+        if (!tokens.isEmpty() && type == Latin && lastType == Latin) {
+            Token &token = tokens.last();
+            token.end += length;
+            token.width += 1;
+        } else {
+            tokens.append({pos, pos + length, charWidth(type), type == Space});
+        }
+
+        lastType = type;
+        pos += length;
+    }
+    return tokens;
+}
+
+QString wrapLine(const QString &line, int width, bool once)
+{
+    QStringList lines;
+
+    // 行缓冲总是 line 中连续的一段 [bufferBegin, bufferEnd)
+    int bufferBegin = 0;
+    int bufferEnd = 0;
+    int currentWidth = 0;
+
+    for (const Token &token : tokenize(line)) {
+        if (token.isSpace && currentWidth == 0) {
+            continue;
+        }
+
+        if (currentWidth + token.width <= width) {
+            if (currentWidth == 0) {
+                bufferBegin = token.begin;
+            }
+            bufferEnd = token.end;
+            currentWidth += token.width;
+
+            if (currentWidth == width) {
+                lines << rstripped(line, bufferBegin, bufferEnd);
+                currentWidth = 0;
+            }
+            continue;
+        }
+
+        if (currentWidth != 0) {
+            lines << rstripped(line, bufferBegin, bufferEnd);
+        }
+
+        // 超长的词按 width 个 UTF-16 单元截断，不拆开代理对
+        int chunkBegin = token.begin;
+        while (token.end - chunkBegin > width) {
+            int chunkEnd = chunkBegin + width;
+            if (line.at(chunkEnd - 1).isHighSurrogate()) {
+                ++chunkEnd;
+            }
+            lines << rstripped(line, chunkBegin, chunkEnd);
+            chunkBegin = chunkEnd;
+        }
+        bufferBegin = chunkBegin;
+        bufferEnd = token.end;
+        currentWidth = rangeWidth(line, bufferBegin, bufferEnd);
+    }
+
+    if (currentWidth != 0) {
+        lines << rstripped(line, bufferBegin, bufferEnd);
+    }
+
+    if (once && lines.size() > 1) {
+        return lines.first() + QLatin1Char('\n') + lines.mid(1).join(QLatin1Char(' '));
+    }
+    return lines.join(QLatin1Char('\n'));
+}
+
+std::pair<QString, bool> wrapText(const QString &text, int width, bool once)
+{
+    width = qMax(1, width);
+
+    QString normalized = text;
+    normalized.replace(QLatin1String("\r\n"), QLatin1String("\n")).replace(QLatin1Char('\r'), QLatin1Char('\n'));
+    QStringList lines = normalized.split(QLatin1Char('\n'));
+    if (normalized.endsWith(QLatin1Char('\n'))) {
+        lines.removeLast();
+    }
+
+    QStringList wrappedLines;
+    bool isWrapped = false;
+
+    for (int i = 0; i < lines.size(); ++i) {
+        const QString line = lines.at(i).simplified();
+        if (rangeWidth(line, 0, line.size()) <= width) {
+            wrappedLines << line;
+            continue;
+        }
+
+        isWrapped = true;
+        QString wrappedLine = wrapLine(line, width, once);
+        if (once) {
+            // 只折一次：其余各行接在第二行之后
+            QStringList rest;
+            for (int j = i + 1; j < lines.size(); ++j) {
+                const QString next = lines.at(j).simplified();
+                if (!next.isEmpty()) {
+                    rest << next;
+                }
+            }
+            if (!rest.isEmpty()) {
+                wrappedLine += QLatin1Char(' ') + rest.join(QLatin1Char(' '));
+            }
+            wrappedLines << wrappedLine;
+            break;
+        }
+        wrappedLines << wrappedLine;
+    }
+
+    return {wrappedLines.join(QLatin1Char('\n')), isWrapped};
+}
+
+struct Key {
+    QString text;
+    QString font;
+    int width;
+    bool once;
+
+    bool operator==(const Key &other) const
+    {
+        return width == other.width && once == other.once
+               && text == other.text && font == other.font;
+    }
+};
+
+HashValue qHash(const Key &key, HashValue seed = 0)
+{
+    return ::qHash(key.text, seed) ^ ::qHash(key.font, seed) ^ HashValue(key.width * 2 + (key.once ? 1 : 0));
+}
+
+struct Entry {
+    Key key;
+    std::pair<QString, bool> result;
+};
+
+struct Shard {
+    QMutex mutex;
+    std::list<Entry> order;  // 最近使用的在前
+    QHash<Key, std::list<Entry>::iterator> index;
+};
+
+class WrapCache
+{
+public:
+    static WrapCache &instance()
+    {
+        static WrapCache cache;
+        return cache;
+    }
+
+    bool find(const Key &key, HashValue hash, std::pair<QString, bool> *result)
+    {
+        Shard &shard = shardFor(hash);
+        QMutexLocker locker(&shard.mutex);
+
+        auto it = shard.index.constFind(key);
+        if (it == shard.index.constEnd()) {
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        shard.order.splice(shard.order.begin(), shard.order, it.value());
+        *result = it.value()->result;
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void insert(const Key &key, HashValue hash, const std::pair<QString, bool> &result)
+    {
+        const int capacity = m_shardCapacity.load(std::memory_order_relaxed);
+        if (capacity <= 0) {
+            return;
+        }
+
+        Shard &shard = shardFor(hash);
+        QMutexLocker locker(&shard.mutex);
+
+        // 其他线程可能已经算好并插入了同一个键
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            shard.order.splice(shard.order.begin(), shard.order, it.value());
+            return;
+        }
+
+        shard.order.push_front({key, result});
+        shard.index.insert(key, shard.order.begin());
+        trim(shard, capacity);
+    }
+
+    void setCapacity(int size)
+    {
+        size = qMax(0, size);
+        m_capacity.store(size, std::memory_order_relaxed);
+        const int capacity = (size + kShardCount - 1) / kShardCount;
+        m_shardCapacity.store(capacity, std::memory_order_relaxed);
+
+        for (Shard &shard : m_shards) {
+            QMutexLocker locker(&shard.mutex);
+            trim(shard, capacity);
+        }
+    }
+
+    int capacity() const
+    {
+        return m_capacity.load(std::memory_order_relaxed);
+    }
+
+    void clear()
+    {
+        for (Shard &shard : m_shards) {
+            QMutexLocker locker(&shard.mutex);
+            shard.index.clear();
+            shard.order.clear();
+        }
+    }
+
+    TextWrapCache::Statistics statistics() const
+    {
+        TextWrapCache::Statistics stats;
+        stats.hits = m_hits.load(std::memory_order_relaxed);
+        stats.misses = m_misses.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void resetStatistics()
+    {
+        m_hits.store(0, std::memory_order_relaxed);
+        m_misses.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    WrapCache()
+        : m_capacity(kDefaultCacheSize)
+        , m_shardCapacity(kDefaultCacheSize / kShardCount)
+        , m_hits(0)
+        , m_misses(0)
+    {
+    }
+
+    Shard &shardFor(HashValue hash)
+    {
+        // 低位已参与 QHash 的桶选择，分片取高一些的位
+        return m_shards[(hash >> 8) % kShardCount];
+    }
+
+    static void trim(Shard &shard, int capacity)
+    {
+        while (shard.index.size() > capacity) {
+            shard.index.remove(shard.order.back().key);
+            shard.order.pop_back();
+        }
+    }
+
+    Shard m_shards[kShardCount];
+    std::atomic<int> m_capacity;
+    std::atomic<int> m_shardCapacity;
+    std::atomic<qint64> m_hits;
+    std::atomic<qint64> m_misses;
+};
+
+// font 非空时 key.width 是像素宽度，未命中时才换算为字符单位
+std::pair<QString, bool> cachedWrap(const Key &key, const QFont *font)
+{
+    WrapCache &cache = WrapCache::instance();
+    const HashValue hash = qHash(key);
+
+    std::pair<QString, bool> result;
+    if (cache.find(key, hash, &result)) {
+        return result;
+    }
+
+    int width = key.width;
+    if (font) {
+        width /= qMax(1, QFontMetrics(*font).averageCharWidth());
+    }
+
+    // 折行计算放在锁外，不同线程同时未命中同一键时只是多算一次
+    result = wrapText(key.text, width, key.once);
+    cache.insert(key, hash, result);
+    return result;
+}
+}
+
+std::pair<QString, bool> TextWrapCache::wrap(const QString &text, int width, bool once)
+{
+    return cachedWrap(Key{text, QString(), width, once}, nullptr);
+}
+
+std::pair<QString, bool> TextWrapCache::wrap(const QString &text, const QFont &font, int pixelWidth, bool once)
+{
+    return cachedWrap(Key{text, font.key(), pixelWidth, once}, &font);
+}
+
+int TextWrapCache::textWidth(const QString &text)
+{
+    return rangeWidth(text, 0, text.size());
+}
+
+void TextWrapCache::setCacheSize(int size)
+{
+    WrapCache::instance().setCapacity(size);
+}
+
+int TextWrapCache::cacheSize()
+{
+    return WrapCache::instance().capacity();
+}
+
+void TextWrapCache::clearCache()
+{
+    WrapCache::instance().clear();
+}
+
+TextWrapCache::Statistics TextWrapCache::statistics()
+{
+    return WrapCache::instance().statistics();
+}
+
+void TextWrapCache::resetStatistics()
+{
+    WrapCache::instance().resetStatistics();
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <utility>
+
+#include <QFont>
+#include <QString>
+
+/**
+ * @brief 线程安全的文字折行缓存
+ *
+ * 折行规则与 TextWrap::wrap 相同：以字符单位计宽，东亚宽字符占 2，其余占 1，
+ * 连续的拉丁字符作为一个词整体换行，过长的词按宽度截断。
+ *
+ * 结果缓存在 16 个分片的 LRU 中，每个分片各持一把锁，工作线程预先准备通知文字时
+ * 与 GUI 线程的 resize 调用互不阻塞。字符分类走预先建好的查表，中文和 ASCII
+ * 文本不再逐字查询 Unicode 属性。
+ */
+class TextWrapCache
+{
+public:
+    struct Statistics {
+        qint64 hits = 0;
+        qint64 misses = 0;
+
+        qreal hitRate() const
+        {
+            const qint64 total = hits + misses;
+            return total > 0 ? qreal(hits) / total : 0;
+        }
+    };
+
+    /**
+     * @brief 按字符单位折行
+     * @param text 原始文字
+     * @param width 每行最多的字符单位数
+     * @param once 为 true 时只在第一处超宽的位置折一次行
+     * @return 折行后的文字，以及是否发生了折行
+     */
+    static std::pair<QString, bool> wrap(const QString &text, int width, bool once = true);
+
+    /**
+     * @brief 按像素宽度折行，字符单位取字体的平均字符宽度，缓存键包含字体
+     */
+    static std::pair<QString, bool> wrap(const QString &text, const QFont &font, int pixelWidth, bool once = true);
+
+    /**
+     * @brief 文字的字符单位宽度
+     */
+    static int textWidth(const QString &text);
+
+    /**
+     * @brief 设置缓存容量（单位：条目数，平均分到各分片）
+     */
+    static void setCacheSize(int size);
+    static int cacheSize();
+    static void clearCache();
+
+    static Statistics statistics();
+    static void resetStatistics();
+
+private:
+    TextWrapCache() = delete;
+};
@@ -0,0 +1,280 @@
+#include "InfoBarQueue.h"
+
+#include <QTimer>
+#include <QWidget>
+#include <QPainter>
+
+#include "QFluent/InfoBar.h"
+#include "InfoBarTextView.h"
+#include "Theme.h"
+
+namespace {
+constexpr int kDefaultMaximumVisibleCount = 5;
+constexpr int kDefaultAdmissionRate = 4;
+constexpr int kDefaultMaximumPendingCount = 1000;
+constexpr int kBadgeHeight = 18;
+}
+
+/**
+ * @brief 信息栏上的重复次数徽标
+ */
+class InfoBarCounterBadge : public QWidget
+{
+public:
+    explicit InfoBarCounterBadge(QWidget *parent = nullptr)
+        : QWidget(parent)
+        , m_count(1)
+    {
+        QFont font = this->font();
+        font.setPixelSize(11);
+        font.setWeight(QFont::DemiBold);
+        setFont(font);
+        setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+    }
+
+    void setCount(int count)
+    {
+        m_count = count;
+        updateGeometry();
+        update();
+    }
+
+    QSize sizeHint() const override
+    {
+        return QSize(qMax(kBadgeHeight, fontMetrics().horizontalAdvance(text()) + 10), kBadgeHeight);
+    }
+
+protected:
+    void paintEvent(QPaintEvent *) override
+    {
+        QPainter painter(this);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(Theme::instance()->themeColor());
+        painter.drawRoundedRect(rect(), height() / 2.0, height() / 2.0);
+
+        painter.setPen(Theme::instance()->isDarkTheme() ? Qt::black : Qt::white);
+        painter.drawText(rect(), Qt::AlignCenter, text());
+    }
+
+private:
+    QString text() const
+    {
+        return m_count > 99 ? QStringLiteral("99+") : QString::number(m_count);
+    }
+
+    int m_count;
+};
+
+InfoBarQueue::InfoBarQueue(QWidget *parent)
+    : QObject(parent)
+    , m_parent(parent)
+    , m_admissionTimer(new QTimer(this))
+    , m_maximumVisibleCount(kDefaultMaximumVisibleCount)
+    , m_admissionRate(kDefaultAdmissionRate)
+    , m_maximumPendingCount(kDefaultMaximumPendingCount)
+    , m_droppedCount(0)
+    , m_frontId(0)
+{
+    m_admissionTimer->setSingleShot(true);
+    connect(m_admissionTimer, &QTimer::timeout, this, &InfoBarQueue::admitPending);
+}
+
+void InfoBarQueue::setMaximumVisibleCount(int count)
+{
+    m_maximumVisibleCount = qMax(1, count);
+    scheduleAdmission();
+}
+
+void InfoBarQueue::setAdmissionRate(int perSecond)
+{
+    m_admissionRate = qMax(1, perSecond);
+}
+
+void InfoBarQueue::setMaximumPendingCount(int count)
+{
+    m_maximumPendingCount = qMax(0, count);
+
+    bool isChanged = false;
+    while (m_maximumPendingCount > 0 && int(m_pending.size()) > m_maximumPendingCount) {
+        popPending();
+        ++m_droppedCount;
+        isChanged = true;
+    }
+    if (isChanged) {
+        emit pendingCountChanged(pendingCount());
+    }
+}
+
+void InfoBarQueue::push(Fluent::MessageType type, const QString &title, const QString &content,
+                        Qt::Orientation orientation, bool isClosable, int duration,
+                        Fluent::MessagePosition position)
+{
+    const QString key = keyOf(type, title, content);
+
+    // 相同的消息正在显示，只增加计数
+    auto visible = m_visible.find(key);
+    if (visible != m_visible.end() && visible->infoBar) {
+        ++visible->count;
+        updateBadge(*visible);
+        return;
+    }
+
+    // 相同的消息已在排队，合并到原来的位置
+    auto pendingId = m_pendingIds.constFind(key);
+    if (pendingId != m_pendingIds.constEnd()) {
+        ++m_pending[size_t(pendingId.value() - m_frontId)].count;
+        return;
+    }
+
+    const Message message{type, title, content, orientation, isClosable, duration, position, 1};
+    if (m_pending.empty() && canAdmit()) {
+        admit(message);
+        return;
+    }
+
+    if (m_maximumPendingCount > 0 && int(m_pending.size()) >= m_maximumPendingCount) {
+        popPending();
+        ++m_droppedCount;
+    }
+
+    m_pendingIds.insert(key, m_frontId + qint64(m_pending.size()));
+    m_pending.push_back(message);
+
+    emit pendingCountChanged(pendingCount());
+    scheduleAdmission();
+}
+
+void InfoBarQueue::info(const QString &title, const QString &content, int duration)
+{
+    push(Fluent::MessageType::INFORMATION, title, content, Qt::Horizontal, true, duration);
+}
+
+void InfoBarQueue::success(const QString &title, const QString &content, int duration)
+{
+    push(Fluent::MessageType::SUCCESS, title, content, Qt::Horizontal, true, duration);
+}
+
+void InfoBarQueue::warning(const QString &title, const QString &content, int duration)
+{
+    push(Fluent::MessageType::WARNING, title, content, Qt::Horizontal, true, duration);
+}
+
+void InfoBarQueue::error(const QString &title, const QString &content, int duration)
+{
+    push(Fluent::MessageType::ERROR, title, content, Qt::Horizontal, true, duration);
+}
+
+void InfoBarQueue::clearPending()
+{
+    if (m_pending.empty()) {
+        return;
+    }
+
+    m_frontId += qint64(m_pending.size());
+    m_pending.clear();
+    m_pendingIds.clear();
+    m_admissionTimer->stop();
+
+    emit pendingCountChanged(0);
+}
+
+QString InfoBarQueue::keyOf(Fluent::MessageType type, const QString &title, const QString &content)
+{
+    return QString::number(int(type)) + QLatin1Char('\x1f') + title + QLatin1Char('\x1f') + content;
+}
+
+bool InfoBarQueue::canAdmit() const
+{
+    if (!m_parent || m_visible.size() >= m_maximumVisibleCount) {
+        return false;
+    }
+    return !m_lastAdmission.isValid() || m_lastAdmission.elapsed() >= 1000 / m_admissionRate;
+}
+
+void InfoBarQueue::admit(const Message &message)
+{
+    const QString key = keyOf(message.type, message.title, message.content);
+
+    InfoBar *infoBar = InfoBarTextView::newInfoBar(message.type, message.title, message.content,
+                                                   message.orientation, message.isClosable,
+                                                   message.duration, message.position, m_parent);
+    m_lastAdmission.start();
+
+    VisibleBar &bar = m_visible[key];
+    bar.infoBar = infoBar;
+    bar.badge = nullptr;
+    bar.count = message.count;
+    updateBadge(bar);
+
+    // 淡出开始后就不再往这条信息栏上合并，腾出的名额交给排队的消息
+    connect(infoBar, &InfoBar::closedSignal, this, [this, key, infoBar]() {
+        auto it = m_visible.find(key);
+        if (it != m_visible.end() && it->infoBar == infoBar) {
+            m_visible.erase(it);
+            scheduleAdmission();
+        }
+    });
+    connect(infoBar, &QObject::destroyed, this, [this, key]() {
+        auto it = m_visible.find(key);
+        if (it != m_visible.end() && it->infoBar.isNull()) {
+            m_visible.erase(it);
+            scheduleAdmission();
+        }
+    });
+}
+
+void InfoBarQueue::admitPending()
+{
+    if (m_pending.empty() || !canAdmit()) {
+        scheduleAdmission();
+        return;
+    }
+
+    const Message message = m_pending.front();
+    popPending();
+    admit(message);
+
+    emit pendingCountChanged(pendingCount());
+    scheduleAdmission();
+}
+
+void InfoBarQueue::popPending()
+{
+    const Message &message = m_pending.front();
+    const QString key = keyOf(message.type, message.title, message.content);
+
+    auto it = m_pendingIds.find(key);
+    if (it != m_pendingIds.end() && it.value() == m_frontId) {
+        m_pendingIds.erase(it);
+    }
+
+    m_pending.pop_front();
+    ++m_frontId;
+}
+
+void InfoBarQueue::updateBadge(VisibleBar &bar)
+{
+    if (bar.count <= 1 || !bar.infoBar) {
+        return;
+    }
+
+    if (!bar.badge) {
+        bar.badge = new InfoBarCounterBadge(bar.infoBar);
+        bar.infoBar->addWidget(bar.badge);
+    }
+    bar.badge->setCount(bar.count);
+}
+
+void InfoBarQueue::scheduleAdmission()
+{
+    // 名额已满时等信息栏关闭再调度，不空转定时器
+    if (m_pending.empty() || m_admissionTimer->isActive()
+            || m_visible.size() >= m_maximumVisibleCount) {
+        return;
+    }
+
+    const int interval = 1000 / m_admissionRate;
+    const qint64 elapsed = m_lastAdmission.isValid() ? m_lastAdmission.elapsed() : interval;
+    m_admissionTimer->start(int(qMax<qint64>(0, interval - elapsed)));
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <deque>
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QElapsedTimer>
+
+#include "FluentGlobal.h"
+
+class QTimer;
+class QWidget;
+class InfoBar;
+class InfoBarCounterBadge;
+
+/**
+ * @brief 限流、合并的信息栏队列
+ *
+ * 同一窗口上同时显示的信息栏数量和每秒新建的数量都有上限，超出部分只以数据形式
+ * 排在待显示队列中，不创建任何控件；类型、标题、内容都相同的消息合并为一条，
+ * 在信息栏上用计数徽标显示重复次数。告警风暴下 InfoBarManager 的滑入和下落动画
+ * 数量始终受显示上限约束。
+ *
+ * 信息栏通过 InfoBarTextView 的工厂方法创建。
+ */
+class InfoBarQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit InfoBarQueue(QWidget *parent);
+
+    /**
+     * @brief 同时显示的信息栏上限
+     */
+    void setMaximumVisibleCount(int count);
+    int maximumVisibleCount() const { return m_maximumVisibleCount; }
+
+    /**
+     * @brief 每秒最多新建的信息栏数量
+     */
+    void setAdmissionRate(int perSecond);
+    int admissionRate() const { return m_admissionRate; }
+
+    /**
+     * @brief 待显示队列上限，超出时丢弃最早的消息
+     */
+    void setMaximumPendingCount(int count);
+    int maximumPendingCount() const { return m_maximumPendingCount; }
+
+    void push(Fluent::MessageType type,
+              const QString &title,
+              const QString &content,
+              Qt::Orientation orientation = Qt::Horizontal,
+              bool isClosable = true,
+              int duration = 2000,
+              Fluent::MessagePosition position = Fluent::MessagePosition::TOP_RIGHT);
+
+    void info(const QString &title, const QString &content, int duration = 2000);
+    void success(const QString &title, const QString &content, int duration = 2000);
+    void warning(const QString &title, const QString &content, int duration = 2000);
+    void error(const QString &title, const QString &content, int duration = 2000);
+
+    int visibleCount() const { return m_visible.size(); }
+    int pendingCount() const { return int(m_pending.size()); }
+
+    /**
+     * @brief 因待显示队列已满而丢弃的消息数
+     */
+    qint64 droppedCount() const { return m_droppedCount; }
+
+    /**
+     * @brief 清空待显示队列，已显示的信息栏不受影响
+     */
+    void clearPending();
+
+signals:
+    void pendingCountChanged(int count);
+
+private:
+    struct Message {
+        Fluent::MessageType type;
+        QString title;
+        QString content;
+        Qt::Orientation orientation;
+        bool isClosable;
+        int duration;
+        Fluent::MessagePosition position;
+        int count;
+    };
+
+    struct VisibleBar {
+        QPointer<InfoBar> infoBar;
+        QPointer<InfoBarCounterBadge> badge;
+        int count = 0;
+    };
+
+    static QString keyOf(Fluent::MessageType type, const QString &title, const QString &content);
+
+    bool canAdmit() const;
+    void admit(const Message &message);
+    void admitPending();
+    void popPending();
+    void updateBadge(VisibleBar &bar);
+    void scheduleAdmission();
+
+    QPointer<QWidget> m_parent;
+    QTimer *m_admissionTimer;
+    QElapsedTimer m_lastAdmission;
+
+    int m_maximumVisibleCount;
+    int m_admissionRate;
+    int m_maximumPendingCount;
+    qint64 m_droppedCount;
+
+    // 待显示消息；m_pendingIds 记录键对应消息的序号，序号减去队首序号即为下标
+    std::deque<Message> m_pending;
+    QHash<QString, qint64> m_pendingIds;
+    qint64 m_frontId;
+
+    QHash<QString, VisibleBar> m_visible;
+};
@@ -0,0 +1,283 @@
+#include "InfoBarTextView.h"
+
+#include <QEvent>
+#include <QtMath>
+#include <QPainter>
+#include <QTextLayout>
+
+#include "QFluent/InfoBar.h"
+#include "Theme.h"
+
+namespace {
+constexpr int kTitleContentSpacing = 12;
+constexpr int kLineSpacing = 2;
+constexpr int kMinContentWidth = 120;
+constexpr int kDefaultMaximumTextWidth = 600;
+constexpr int kMaxCachedLayouts = 256;
+constexpr qreal kUnboundedLineWidth = 1e6;
+}
+
+InfoBarTextView::InfoBarTextView(const QString &title, const QString &content,
+                                 Qt::Orientation orientation, QWidget *parent)
+    : QWidget(parent)
+    , m_title(title)
+    , m_content(content)
+    , m_orientation(orientation)
+    , m_maximumTextWidth(kDefaultMaximumTextWidth)
+    , m_layoutWidth(-1)
+    , m_naturalWidth(-1)
+{
+    initWidget();
+}
+
+void InfoBarTextView::initWidget()
+{
+    // 与 InfoBar 标签的样式表保持一致：14px，标题加粗
+    QFont font = this->font();
+    font.setPixelSize(14);
+    setFont(font);
+
+    QSizePolicy policy(QSizePolicy::Preferred, QSizePolicy::Preferred);
+    policy.setHeightForWidth(true);
+    setSizePolicy(policy);
+
+    connect(Theme::instance(), &Theme::themeModeChanged, this, [this]() { update(); });
+}
+
+void InfoBarTextView::setMaximumTextWidth(int width)
+{
+    m_maximumTextWidth = qMax(kMinContentWidth, width);
+    updateGeometry();
+}
+
+QSize InfoBarTextView::sizeHint() const
+{
+    const int width = qMin(naturalWidth(), m_maximumTextWidth);
+    return QSize(width, heightForWidth(width));
+}
+
+QSize InfoBarTextView::minimumSizeHint() const
+{
+    const int width = qMin(naturalWidth(), kMinContentWidth);
+    return QSize(width, heightForWidth(width));
+}
+
+bool InfoBarTextView::hasHeightForWidth() const
+{
+    return true;
+}
+
+int InfoBarTextView::heightForWidth(int width) const
+{
+    return layoutFor(width).size.height();
+}
+
+void InfoBarTextView::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    painter.setPen(Theme::instance()->isDarkTheme() ? Qt::white : Qt::black);
+
+    const Layout &layout = layoutFor(width());
+
+    painter.setFont(titleFont());
+    for (int i = 0; i < layout.title.lines.size(); ++i) {
+        painter.drawStaticText(layout.titlePos + QPointF(0, layout.title.offsets.at(i)), layout.title.lines.at(i));
+    }
+
+    painter.setFont(font());
+    for (int i = 0; i < layout.content.lines.size(); ++i) {
+        painter.drawStaticText(layout.contentPos + QPointF(0, layout.content.offsets.at(i)), layout.content.lines.at(i));
+    }
+}
+
+void InfoBarTextView::changeEvent(QEvent *event)
+{
+    if (event->type() == QEvent::FontChange) {
+        invalidateLayout();
+        updateGeometry();
+    }
+    QWidget::changeEvent(event);
+}
+
+QFont InfoBarTextView::titleFont() const
+{
+    QFont font = this->font();
+    font.setWeight(QFont::DemiBold);
+    return font;
+}
+
+const InfoBarTextView::Layout &InfoBarTextView::layoutFor(int width) const
+{
+    width = qMax(1, width);
+    if (width == m_layoutWidth) {
+        return m_layout;
+    }
+
+    Layout layout;
+    bool isHorizontal = m_orientation == Qt::Horizontal && !m_title.isEmpty() && !m_content.isEmpty();
+
+    // 水平方向：标题不折行，内容占用剩余宽度；剩余宽度太窄时退回垂直排列
+    if (isHorizontal) {
+        layout.title = textBlock(m_title, titleFont(), -1);
+        const int titleWidth = qCeil(layout.title.size.width());
+        const int contentWidth = width - titleWidth - kTitleContentSpacing;
+
+        if (contentWidth >= kMinContentWidth) {
+            layout.content = textBlock(m_content, font(), contentWidth);
+            layout.contentPos = QPointF(titleWidth + kTitleContentSpacing, 0);
+            layout.size = QSize(titleWidth + kTitleContentSpacing + qCeil(layout.content.size.width()),
+                                qCeil(qMax(layout.title.size.height(), layout.content.size.height())));
+        } else {
+            isHorizontal = false;
+        }
+    }
+
+    if (!isHorizontal) {
+        layout.title = m_title.isEmpty() ? TextBlock() : textBlock(m_title, titleFont(), width);
+        layout.content = m_content.isEmpty() ? TextBlock() : textBlock(m_content, font(), width);
+
+        qreal y = layout.title.size.height();
+        if (!m_title.isEmpty() && !m_content.isEmpty()) {
+            y += kLineSpacing;
+        }
+        layout.contentPos = QPointF(0, y);
+        layout.size = QSize(qCeil(qMax(layout.title.size.width(), layout.content.size.width())),
+                            qCeil(y + layout.content.size.height()));
+    }
+
+    m_layoutWidth = width;
+    m_layout = layout;
+    return m_layout;
+}
+
+int InfoBarTextView::naturalWidth() const
+{
+    if (m_naturalWidth >= 0) {
+        return m_naturalWidth;
+    }
+
+    const int titleWidth = m_title.isEmpty() ? 0 : qCeil(textBlock(m_title, titleFont(), -1).size.width());
+    const int contentWidth = m_content.isEmpty() ? 0 : qCeil(textBlock(m_content, font(), -1).size.width());
+
+    if (m_orientation == Qt::Horizontal && titleWidth > 0 && contentWidth > 0) {
+        m_naturalWidth = titleWidth + kTitleContentSpacing + contentWidth;
+    } else {
+        m_naturalWidth = qMax(titleWidth, contentWidth);
+    }
+    return m_naturalWidth;
+}
+
+void InfoBarTextView::invalidateLayout()
+{
+    m_layoutWidth = -1;
+    m_naturalWidth = -1;
+}
+
+QCache<QString, InfoBarTextView::TextBlock> &InfoBarTextView::layoutCache()
+{
+    // 只在 GUI 线程使用
+    static QCache<QString, TextBlock> cache(kMaxCachedLayouts);
+    return cache;
+}
+
+InfoBarTextView::TextBlock InfoBarTextView::textBlock(const QString &text, const QFont &font, int width)
+{
+    const QString key = font.key() + QLatin1Char('\x1f') + QString::number(width) + QLatin1Char('\x1f') + text;
+
+    QCache<QString, TextBlock> &cache = layoutCache();
+    if (TextBlock *cached = cache.object(key)) {
+        return *cached;
+    }
+
+    QString layoutText = text;
+    layoutText.replace(QLatin1Char('\n'), QChar::LineSeparator);
+
+    QTextOption option;
+    option.setWrapMode(width < 0 ? QTextOption::NoWrap : QTextOption::WrapAtWordBoundaryOrAnywhere);
+
+    QTextLayout textLayout(layoutText, font);
+    textLayout.setTextOption(option);
+
+    auto block = new TextBlock;
+    qreal y = 0;
+    qreal maxWidth = 0;
+
+    textLayout.beginLayout();
+    for (;;) {
+        QTextLine line = textLayout.createLine();
+        if (!line.isValid()) {
+            break;
+        }
+
+        line.setLineWidth(width < 0 ? kUnboundedLineWidth : width);
+        line.setPosition(QPointF(0, y));
+
+        // 每行单独准备成 QStaticText，绘制时不再排版
+        QString lineText = layoutText.mid(line.textStart(), line.textLength());
+        while (!lineText.isEmpty() && lineText.at(lineText.size() - 1).isSpace()) {
+            lineText.chop(1);
+        }
+
+        QStaticText staticText(lineText);
+        staticText.setTextFormat(Qt::PlainText);
+        staticText.setPerformanceHint(QStaticText::AggressiveCaching);
+        staticText.prepare(QTransform(), font);
+
+        block->lines << staticText;
+        block->offsets << y;
+
+        y += line.height();
+        maxWidth = qMax(maxWidth, line.naturalTextWidth());
+    }
+    textLayout.endLayout();
+
+    block->size = QSizeF(maxWidth, y);
+    cache.insert(key, block);
+    return *block;
+}
+
+void InfoBarTextView::clearLayoutCache()
+{
+    layoutCache().clear();
+}
+
+InfoBar *InfoBarTextView::newInfoBar(Fluent::MessageType type, const QString &title, const QString &content,
+                                     Qt::Orientation orientation, bool isClosable, int duration,
+                                     Fluent::MessagePosition position, QWidget *parent)
+{
+    // 标题和内容留空，InfoBar 自带的标签不显示，也不会再走 TextWrap 折行
+    auto infoBar = new InfoBar(type, QString(), QString(), orientation, isClosable, duration, position, parent);
+
+    auto textView = new InfoBarTextView(title, content, orientation, infoBar);
+    if (parent) {
+        textView->setMaximumTextWidth(qMin(kDefaultMaximumTextWidth, parent->width() - 200));
+    }
+    infoBar->addWidget(textView, 1);
+
+    infoBar->show();
+    return infoBar;
+}
+
+InfoBar *InfoBarTextView::info(const QString &title, const QString &content, Qt::Orientation orientation,
+                               bool isClosable, int duration, Fluent::MessagePosition position, QWidget *parent)
+{
+    return newInfoBar(Fluent::MessageType::INFORMATION, title, content, orientation, isClosable, duration, position, parent);
+}
+
+InfoBar *InfoBarTextView::success(const QString &title, const QString &content, Qt::Orientation orientation,
+                                  bool isClosable, int duration, Fluent::MessagePosition position, QWidget *parent)
+{
+    return newInfoBar(Fluent::MessageType::SUCCESS, title, content, orientation, isClosable, duration, position, parent);
+}
+
+InfoBar *InfoBarTextView::warning(const QString &title, const QString &content, Qt::Orientation orientation,
+                                  bool isClosable, int duration, Fluent::MessagePosition position, QWidget *parent)
+{
+    return newInfoBar(Fluent::MessageType::WARNING, title, content, orientation, isClosable, duration, position, parent);
+}
+
+InfoBar *InfoBarTextView::error(const QString &title, const QString &content, Qt::Orientation orientation,
+                                bool isClosable, int duration, Fluent::MessagePosition position, QWidget *parent)
+{
+    return newInfoBar(Fluent::MessageType::ERROR, title, content, orientation, isClosable, duration, position, parent);
+}
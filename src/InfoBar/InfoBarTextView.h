@@ -0,0 +1,113 @@
+#pragma once
+
+#include <QCache>
+#include <QVector>
+#include <QWidget>
+#include <QStaticText>
+
+#include "FluentGlobal.h"
+
+class InfoBar;
+
+/**
+ * @brief 预先排版的信息栏文字
+ *
+ * 标题和内容按 (文字, 宽度, 字体) 排版一次，折行结果连同每行的 QStaticText
+ * 放进全局缓存，paintEvent 直接贴字形，sizeHint / heightForWidth 也取自缓存，
+ * 不再经过 QLabel 的二次排版。监控数据一次推来大量相同的告警时，只有第一条需要排版。
+ *
+ * 通过 newInfoBar / info / success / warning / error 创建的 InfoBar 不带标题、内容标签，
+ * 文字完全由本控件绘制，参数与 InfoBar 的同名工厂方法一致。
+ */
+class InfoBarTextView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit InfoBarTextView(const QString &title, const QString &content,
+                             Qt::Orientation orientation = Qt::Horizontal, QWidget *parent = nullptr);
+
+    QString title() const { return m_title; }
+    QString content() const { return m_content; }
+
+    /**
+     * @brief 设置未折行时的最大文字宽度，sizeHint 不会超过该值
+     */
+    void setMaximumTextWidth(int width);
+    int maximumTextWidth() const { return m_maximumTextWidth; }
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+    bool hasHeightForWidth() const override;
+    int heightForWidth(int width) const override;
+
+    static InfoBar *newInfoBar(Fluent::MessageType type,
+                               const QString &title,
+                               const QString &content,
+                               Qt::Orientation orientation = Qt::Horizontal,
+                               bool isClosable = true,
+                               int duration = 1000,
+                               Fluent::MessagePosition position = Fluent::MessagePosition::TOP_RIGHT,
+                               QWidget *parent = nullptr);
+
+    static InfoBar *info(const QString &title, const QString &content,
+                         Qt::Orientation orientation = Qt::Horizontal, bool isClosable = true, int duration = 1000,
+                         Fluent::MessagePosition position = Fluent::MessagePosition::TOP_RIGHT, QWidget *parent = nullptr);
+
+    static InfoBar *success(const QString &title, const QString &content,
+                            Qt::Orientation orientation = Qt::Horizontal, bool isClosable = true, int duration = 1000,
+                            Fluent::MessagePosition position = Fluent::MessagePosition::TOP_RIGHT, QWidget *parent = nullptr);
+
+    static InfoBar *warning(const QString &title, const QString &content,
+                            Qt::Orientation orientation = Qt::Horizontal, bool isClosable = true, int duration = 1000,
+                            Fluent::MessagePosition position = Fluent::MessagePosition::TOP_RIGHT, QWidget *parent = nullptr);
+
+    static InfoBar *error(const QString &title, const QString &content,
+                          Qt::Orientation orientation = Qt::Horizontal, bool isClosable = true, int duration = 1000,
+                          Fluent::MessagePosition position = Fluent::MessagePosition::TOP_RIGHT, QWidget *parent = nullptr);
+
+    /**
+     * @brief 清空全局排版缓存
+     */
+    static void clearLayoutCache();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void changeEvent(QEvent *event) override;
+
+private:
+    // 一段文字排版后的结果，按行保存
+    struct TextBlock {
+        QVector<QStaticText> lines;
+        QVector<qreal> offsets;
+        QSizeF size;
+    };
+
+    struct Layout {
+        TextBlock title;
+        TextBlock content;
+        QPointF titlePos;
+        QPointF contentPos;
+        QSize size;
+    };
+
+    // 键为 字体 + 宽度 + 文字，宽度为 -1 表示不折行
+    static QCache<QString, TextBlock> &layoutCache();
+    static TextBlock textBlock(const QString &text, const QFont &font, int width);
+
+    void initWidget();
+    QFont titleFont() const;
+    const Layout &layoutFor(int width) const;
+    int naturalWidth() const;
+    void invalidateLayout();
+
+    QString m_title;
+    QString m_content;
+    Qt::Orientation m_orientation;
+    int m_maximumTextWidth;
+
+    // 最近一次排版的宽度和结果，paintEvent 与 heightForWidth 一般使用同一宽度
+    mutable int m_layoutWidth;
+    mutable Layout m_layout;
+    mutable int m_naturalWidth;
+};
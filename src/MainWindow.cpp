@@ -14,12 +14,16 @@
 #include "ScrollInterface.h"
 
 #include "ConfigManager.h"
+#include "Common/AnimationGovernor.h"
+#include "Router/RouteHistory.h"
 
 using FIT = Fluent::IconType;
 using NIP = Fluent::NavigationItemPosition;
 using FWB = Fluent::WindowButtonHint;
 
 MainWindow::MainWindow()
+    : m_session(new TabSession("tabs.session", this))
+    , m_tabCount(0)
 {
     setWindowTitle("QFluentKit");
     setWindowButtonHints(FWB::Close | FWB::Maximize | FWB::Minimize | FWB::ThemeToggle);
@@ -29,6 +33,8 @@ MainWindow::MainWindow()
     initWidget();
 
     initTabBar();
+
+    AnimationGovernor::instance()->watch(this);
 }
 
 void MainWindow::initTabBar()
@@ -41,15 +47,17 @@ void MainWindow::initTabBar()
     leftButton->setCheckable(false);
     hBoxLayout->addWidget(leftButton, 0, Qt::AlignLeft);
 
-    m_tabBar = new TabBar(windowBar);
+    m_tabBar = new VirtualTabBar(windowBar);
     hBoxLayout->addWidget(m_tabBar, 1, Qt::AlignBottom);
 
-    connect(m_tabBar, &TabBar::tabAddRequested, this, [this](){ addTab(); });
-    connect(m_tabBar, &TabBar::tabCloseRequested, this, [this](int index){ removeTab(index); });
-    connect(m_tabBar, &TabBar::tabBarClicked, this, [=](int index){
+    connect(m_tabBar, &VirtualTabBar::itemCreated, this, [this](TabItem *item){ setHitTestVisible(item, true); });
+    connect(m_tabBar, &VirtualTabBar::tabAddRequested, this, [this](){ addTab(); });
+    connect(m_tabBar, &VirtualTabBar::tabCloseRequested, this, [this](int index){ removeTab(index); });
+    connect(m_tabBar, &VirtualTabBar::tabBarClicked, this, [=](int index){
         m_navigationBar->setCurrentItem("1");
-        const QString routeKey = m_tabBar->tabItem(index)->routeKey();
-        m_stackedWidget->setCurrentWidget(m_stackedWidget->findChild<QWidget *>(routeKey));
+        const QString routeKey = m_tabBar->routeKey(index);
+        m_stackedWidget->setCurrentWidget(ensurePage(routeKey));
+        RouteHistory::instance()->push(m_stackedWidget, routeKey);
     });
 
     auto avatar = new TransparentDropDownToolButton(FluentIcon(":/res/avatar.png"), this);
@@ -62,7 +70,51 @@ void MainWindow::initTabBar()
     setHitTestVisible(m_tabBar->addButton(), true);
     setHitTestVisible(leftButton, true);
     setHitTestVisible(avatar, true);
-    addTab();
+
+    restoreSession();
+
+    connect(m_tabBar, &VirtualTabBar::tabMoved, m_session, &TabSession::moveTab);
+    connect(m_tabBar, &VirtualTabBar::currentChanged, this, [this](int index){
+        if (index >= 0) {
+            m_session->setCurrentTab(m_tabBar->routeKey(index));
+        }
+    });
+}
+
+void MainWindow::restoreSession()
+{
+    // 恢复时只添加标签，页面在第一次激活时由 ensurePage 创建
+    const QVector<TabSession::Tab> tabs = m_session->restore();
+    if (tabs.isEmpty()) {
+        addTab();
+        return;
+    }
+
+    for (const TabSession::Tab &tab : tabs) {
+        m_tabBar->addTab(tab.routeKey, tab.title, QIcon(tab.iconPath));
+        m_tabCount = qMax(m_tabCount, tab.routeKey.section('_', -1).toInt());
+    }
+
+    const QString routeKey = m_session->currentRouteKey();
+    m_tabBar->setCurrentTab(m_tabBar->indexOf(routeKey) >= 0 ? routeKey : tabs.first().routeKey);
+    m_stackedWidget->setCurrentWidget(ensurePage(m_tabBar->currentRouteKey()));
+}
+
+QWidget *MainWindow::ensurePage(const QString &routeKey)
+{
+    // 预取的页面已是 m_stackedWidget 的子控件但还未加入，要先于 findChild 取走
+    if (QWidget *page = m_prefetcher->take(routeKey)) {
+        m_stackedWidget->addWidget(page);
+        return page;
+    }
+
+    if (QWidget *page = m_stackedWidget->findChild<QWidget *>(routeKey)) {
+        return page;
+    }
+
+    QWidget *page = createWidget(routeKey.section('_', -1).toInt(), routeKey);
+    m_stackedWidget->addWidget(page);
+    return page;
 }
 
 void MainWindow::initWidget()
@@ -70,7 +122,8 @@ void MainWindow::initWidget()
     m_navigationBar = new NavigationBar(this);
     m_navigationBar->addItem("1", FluentIcon(FIT::QUICK_NOTE), "标签", [=](){
         if (m_tabBar->count() > 0) {
-            switchWidget(m_tabBar->currentTab()->routeKey());
+            ensurePage(m_tabBar->currentRouteKey());
+            switchWidget(m_tabBar->currentRouteKey());
         } else {
             switchWidget("emptyWidget");
         }
@@ -94,6 +147,15 @@ void MainWindow::initWidget()
     m_stackedWidget->addWidget(new SettingInterface(this));
     m_stackedWidget->addWidget(createWidget(-1, "emptyWidget_2"));
 
+    // 只预取尚未创建的标签页，其余页面启动时已经创建
+    m_prefetcher = new PagePrefetcher(m_stackedWidget, this);
+    m_prefetcher->setPageFactory([this](const QString &routeKey) -> QWidget * {
+        if (m_tabBar->indexOf(routeKey) < 0 || m_stackedWidget->findChild<QWidget *>(routeKey)) {
+            return nullptr;
+        }
+        return createWidget(routeKey.section('_', -1).toInt(), routeKey);
+    });
+
     auto widget = new QWidget(this);
     auto layout = new QHBoxLayout(widget);
     layout->setContentsMargins(0, 0, 0, 0);
@@ -106,12 +168,13 @@ void MainWindow::initWidget()
 
 void MainWindow::addTab()
 {
-    static int tabCount = 0;
-    int count = ++tabCount;
+    int count = ++m_tabCount;
     const QString routeKey = QString("objectName_%1").arg(count);
+    const QString title = QString("新建标签x%1").arg(count);
+    const QString iconPath = ":/res/tab.png";
 
-    auto tab = m_tabBar->addTab(routeKey, QString("新建标签x%1").arg(count), QIcon(":/res/tab.png"));
-    setHitTestVisible(tab, true);
+    m_tabBar->addTab(routeKey, title, QIcon(iconPath));
+    m_session->insertTab(m_tabBar->count() - 1, {routeKey, title, iconPath, QByteArray()});
 
     m_stackedWidget->addWidget(createWidget(count, routeKey));
 
@@ -125,13 +188,17 @@ void MainWindow::addTab()
 
 void MainWindow::removeTab(int index)
 {
-    const QString routeKey = m_tabBar->tabItem(index)->routeKey();
-    m_stackedWidget->removeWidget(m_stackedWidget->findChild<QWidget *>(routeKey));
+    const QString routeKey = m_tabBar->routeKey(index);
+    m_prefetcher->cancel(routeKey);
+    if (QWidget *page = m_stackedWidget->findChild<QWidget *>(routeKey)) {
+        m_stackedWidget->removeWidget(page);
+    }
+    m_session->removeTab(routeKey);
     m_tabBar->removeTab(index);
     if (m_tabBar->count() > 0) {
-        const QString routeKey = m_tabBar->currentTab()->routeKey();
+        const QString routeKey = m_tabBar->currentRouteKey();
         if (m_stackedWidget->currentWidget()->objectName() != routeKey) {
-            m_stackedWidget->setCurrentWidget(m_stackedWidget->findChild<QWidget *>(routeKey));
+            m_stackedWidget->setCurrentWidget(ensurePage(routeKey));
         }
     }
 }
@@ -149,6 +216,7 @@ void MainWindow::showDialog()
 void MainWindow::switchWidget(const QString &objectName)
 {
     m_stackedWidget->setCurrentWidget(m_stackedWidget->findChild<QWidget *>(objectName), false);
+    RouteHistory::instance()->push(m_stackedWidget, objectName);
 }
 
 
@@ -169,6 +237,7 @@ QWidget *MainWindow::createWidget(int index, const QString &objectName)
     vBoxLayout->addStretch();
     vBoxLayout->addWidget(image, 0, Qt::AlignCenter);
     vBoxLayout->addWidget(label, 0, Qt::AlignCenter);
+
     vBoxLayout->addStretch();
 
     return w;
@@ -5,7 +5,9 @@
 #include "QFluent/Label.h"
 #include "QFluent/StackedWidget.h"
 #include "QFluent/Navigation/NavigationBar.h"
-#include "QFluent/TabBar.h"
+#include "TabBar/VirtualTabBar.h"
+#include "TabBar/TabSession.h"
+#include "Router/PagePrefetcher.h"
 
 
 class MainWindow : public FluentWindow {
@@ -18,12 +20,19 @@ public:
 private:
     StackedWidget *m_stackedWidget;
     NavigationBar *m_navigationBar;
-    TabBar *m_tabBar;
+    VirtualTabBar *m_tabBar;
+    TabSession *m_session;
+    PagePrefetcher *m_prefetcher;
+    int m_tabCount;
 
     void addTab();
 
     void removeTab(int index);
 
+    void restoreSession();
+
+    QWidget *ensurePage(const QString &routeKey);
+
     void initTabBar();
 
     void initWidget();
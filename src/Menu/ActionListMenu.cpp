@@ -0,0 +1,552 @@
+#include "ActionListMenu.h"
+
+#include <QEvent>
+#include <QScreen>
+#include <QAction>
+#include <QPainter>
+#include <QKeyEvent>
+#include <QGuiApplication>
+
+#include "Theme.h"
+#include "../Common/NinePatchShadow.h"
+
+namespace {
+constexpr int kDefaultItemHeight = 28;
+constexpr int kSeparatorHeight = 9;
+constexpr int kItemMargin = 6;
+constexpr int kItemPadding = 10;
+constexpr int kItemRadius = 5;
+constexpr int kIconSize = 16;
+constexpr int kIconSpacing = 12;
+constexpr int kShortcutSpacing = 24;
+
+constexpr int kBorderRadius = 8;
+constexpr int kViewPadding = 4;
+constexpr int kShadowLeft = 12;
+constexpr int kShadowTop = 8;
+constexpr int kShadowRight = 12;
+constexpr int kShadowBottom = 20;
+constexpr int kShadowBlur = 6;
+constexpr int kShadowOffset = 4;
+
+constexpr int kMinMenuWidth = 120;
+constexpr int kMaxMenuWidth = 600;
+constexpr int kWidthSampleSize = 128;
+constexpr int kLayoutBatchSize = 256;
+
+/**
+ * @brief 菜单展开动画
+ *
+ * 动画本身没有状态，补间由 AnimationClock 推进，同一类型的所有菜单共用一个实例，
+ * 打开菜单时不再创建动画管理器和属性动画。
+ */
+class MenuSlideAnimation
+{
+public:
+    static const MenuSlideAnimation &forType(Fluent::MenuAnimation type)
+    {
+        static const MenuSlideAnimation animations[] = {
+            MenuSlideAnimation(false, false),   // NONE
+            MenuSlideAnimation(true, false),    // DROP_DOWN
+            MenuSlideAnimation(true, false),    // PULL_UP
+            MenuSlideAnimation(true, true),     // FADE_IN_DROP_DOWN
+            MenuSlideAnimation(true, true)      // FADE_IN_PULL_UP
+        };
+        return animations[qBound(0, int(type), 4)];
+    }
+
+    bool isAnimated() const { return m_isAnimated; }
+
+    /**
+     * @brief 在窗口显示前调用，把面板和透明度设为起点
+     */
+    void prepare(QWidget *window, QWidget *surface) const
+    {
+        surface->move(0, 0);
+        window->setWindowOpacity(m_isFade ? 0 : 1);
+    }
+
+    /**
+     * @brief 面板从窗口外滑入，由窗口边界裁剪，不需要每帧更新遮罩
+     */
+    AnimationClock::TweenId start(QWidget *window, QWidget *surface, bool isPullUp) const
+    {
+        const int offset = (isPullUp ? 1 : -1) * window->height() / 2;
+        const bool isFade = m_isFade;
+        surface->move(0, offset);
+
+        return AnimationClock::instance()->start(0, 1, m_spec, [window, surface, offset, isFade](qreal progress) {
+            surface->move(0, qRound(offset * (1 - progress)));
+            if (isFade) {
+                window->setWindowOpacity(progress);
+            }
+        }, nullptr, window);
+    }
+
+private:
+    MenuSlideAnimation(bool isAnimated, bool isFade)
+        : m_isAnimated(isAnimated)
+        , m_isFade(isAnimated && isFade)
+    {
+    }
+
+    bool m_isAnimated;
+    bool m_isFade;
+    AnimationClock::Spec m_spec;
+};
+}
+
+ActionListModel::ActionListModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int ActionListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_actions.size();
+}
+
+QVariant ActionListModel::data(const QModelIndex &index, int role) const
+{
+    QAction *action = this->action(index.row());
+    if (!index.isValid() || !action) {
+        return QVariant();
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return action->text();
+    case Qt::DecorationRole:
+        return action->icon();
+    case SeparatorRole:
+        return action->isSeparator();
+    case ShortcutRole:
+        return action->shortcut().toString(QKeySequence::NativeText);
+    default:
+        return QVariant();
+    }
+}
+
+Qt::ItemFlags ActionListModel::flags(const QModelIndex &index) const
+{
+    QAction *action = this->action(index.row());
+    if (!action || action->isSeparator() || !action->isEnabled()) {
+        return Qt::NoItemFlags;
+    }
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+}
+
+void ActionListModel::insertActions(int row, const QList<QAction *> &actions)
+{
+    if (actions.isEmpty()) {
+        return;
+    }
+
+    row = (row < 0 || row > m_actions.size()) ? m_actions.size() : row;
+    beginInsertRows(QModelIndex(), row, row + actions.size() - 1);
+    for (int i = 0; i < actions.size(); ++i) {
+        m_actions.insert(row + i, actions.at(i));
+        watch(actions.at(i));
+    }
+    endInsertRows();
+}
+
+void ActionListModel::removeAction(QAction *action)
+{
+    const int row = m_actions.indexOf(action);
+    if (row < 0) {
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), row, row);
+    m_actions.removeAt(row);
+    m_iconActions.remove(action);
+    disconnect(action, nullptr, this, nullptr);
+    endRemoveRows();
+}
+
+void ActionListModel::clear()
+{
+    beginResetModel();
+    for (QAction *action : m_actions) {
+        disconnect(action, nullptr, this, nullptr);
+    }
+    m_actions.clear();
+    m_iconActions.clear();
+    endResetModel();
+}
+
+void ActionListModel::watch(QAction *action)
+{
+    if (!action->icon().isNull()) {
+        m_iconActions.insert(action);
+    }
+
+    connect(action, &QAction::changed, this, [this, action]() {
+        if (action->icon().isNull()) {
+            m_iconActions.remove(action);
+        } else {
+            m_iconActions.insert(action);
+        }
+
+        const int row = m_actions.indexOf(action);
+        if (row >= 0) {
+            emit dataChanged(index(row), index(row));
+        }
+    });
+    connect(action, &QObject::destroyed, this, [this, action]() { removeAction(action); });
+}
+
+ActionItemDelegate::ActionItemDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+    , m_itemHeight(kDefaultItemHeight)
+{
+}
+
+QSize ActionItemDelegate::sizeHint(const QStyleOptionViewItem &, const QModelIndex &index) const
+{
+    return QSize(0, index.data(ActionListModel::SeparatorRole).toBool() ? kSeparatorHeight : m_itemHeight);
+}
+
+void ActionItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    const bool isDark = Theme::instance()->isDarkTheme();
+
+    painter->save();
+    painter->setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing | QPainter::SmoothPixmapTransform);
+
+    if (index.data(ActionListModel::SeparatorRole).toBool()) {
+        const int y = option.rect.center().y();
+        painter->setPen(isDark ? QColor(255, 255, 255, 23) : QColor(0, 0, 0, 25));
+        painter->drawLine(option.rect.left() + kItemMargin, y, option.rect.right() - kItemMargin, y);
+        painter->restore();
+        return;
+    }
+
+    const QRect rect = option.rect.adjusted(kItemMargin, 0, -kItemMargin, 0);
+    const bool isEnabled = option.state & QStyle::State_Enabled;
+    if (isEnabled && (option.state & (QStyle::State_MouseOver | QStyle::State_Selected))) {
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(isDark ? QColor(255, 255, 255, 15) : QColor(0, 0, 0, 9));
+        painter->drawRoundedRect(rect, kItemRadius, kItemRadius);
+    }
+
+    QColor textColor = isDark ? QColor(255, 255, 255) : QColor(0, 0, 0);
+    if (!isEnabled) {
+        textColor.setAlpha(92);
+    }
+
+    int left = rect.left() + kItemPadding;
+    int right = rect.right() - kItemPadding;
+
+    const auto *model = qobject_cast<const ActionListModel *>(index.model());
+    if (model && model->hasIcons()) {
+        const QIcon icon = qvariant_cast<QIcon>(index.data(Qt::DecorationRole));
+        const QRect iconRect(left, rect.top() + (rect.height() - kIconSize) / 2, kIconSize, kIconSize);
+        icon.paint(painter, iconRect, Qt::AlignCenter, isEnabled ? QIcon::Normal : QIcon::Disabled);
+        left += kIconSize + kIconSpacing;
+    }
+
+    painter->setFont(option.font);
+    const QFontMetrics metrics(option.font);
+
+    const QString shortcut = index.data(ActionListModel::ShortcutRole).toString();
+    if (!shortcut.isEmpty()) {
+        QColor shortcutColor = textColor;
+        shortcutColor.setAlpha(isEnabled ? 155 : 92);
+
+        const int width = metrics.horizontalAdvance(shortcut);
+        painter->setPen(shortcutColor);
+        painter->drawText(QRect(right - width, rect.top(), width, rect.height()),
+                          Qt::AlignVCenter | Qt::AlignRight, shortcut);
+        right -= width + kShortcutSpacing;
+    }
+
+    // 只有绘制到的项才测量和省略文字
+    const int textWidth = qMax(0, right - left);
+    const QString text = metrics.elidedText(index.data(Qt::DisplayRole).toString(), Qt::ElideRight, textWidth);
+    painter->setPen(textColor);
+    painter->drawText(QRect(left, rect.top(), textWidth, rect.height()), Qt::AlignVCenter | Qt::AlignLeft, text);
+
+    painter->restore();
+}
+
+ActionListMenu::ActionListMenu(const QString &title, QWidget *parent)
+    : QWidget(parent, Qt::Popup | Qt::FramelessWindowHint | Qt::NoDropShadowWindowHint)
+    , m_surface(new QWidget(this))
+    , m_view(new QListView(m_surface))
+    , m_model(new ActionListModel(this))
+    , m_delegate(new ActionItemDelegate(this))
+    , m_maxVisibleItems(-1)
+    , m_cachedTextWidth(0)
+    , m_cachedShortcutWidth(0)
+    , m_menuWidth(kMinMenuWidth)
+    , m_isWidthDirty(true)
+    , m_isWarm(false)
+    , m_tweenId(0)
+{
+    setWindowTitle(title);
+    setAttribute(Qt::WA_TranslucentBackground);
+    m_surface->installEventFilter(this);
+
+    m_view->setModel(m_model);
+    m_view->setItemDelegate(m_delegate);
+    m_view->setFrameShape(QFrame::NoFrame);
+    m_view->setMouseTracking(true);
+    m_view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_view->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_view->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    m_view->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    m_view->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    m_view->viewport()->setAutoFillBackground(false);
+    m_view->setAutoFillBackground(false);
+
+    // 分批布局：打开时只需要先布局包含可见行的第一批
+    m_view->setLayoutMode(QListView::Batched);
+    m_view->setBatchSize(kLayoutBatchSize);
+
+    Theme::instance()->setFont(m_view, 14);
+
+    // 新增动作时已测得的最大值仍然有效，只需补充抽样；
+    // 删除动作或文字变化后最宽的那项可能已不存在，清空最大值重新抽样
+    const auto invalidateWidth = [this]() { m_isWidthDirty = true; };
+    const auto resetWidth = [this]() {
+        m_cachedTextWidth = 0;
+        m_cachedShortcutWidth = 0;
+        m_isWidthDirty = true;
+    };
+    connect(m_model, &QAbstractItemModel::rowsInserted, this, invalidateWidth);
+    connect(m_model, &QAbstractItemModel::rowsRemoved, this, resetWidth);
+    connect(m_model, &QAbstractItemModel::modelReset, this, resetWidth);
+    connect(m_model, &QAbstractItemModel::dataChanged, this, resetWidth);
+
+    connect(m_view, &QListView::clicked, this, [this](const QModelIndex &index) { triggerRow(index.row()); });
+    connect(m_view, &QListView::entered, this, [this](const QModelIndex &index) { m_view->setCurrentIndex(index); });
+}
+
+void ActionListMenu::addAction(QAction *action)
+{
+    m_model->insertActions(-1, {action});
+}
+
+void ActionListMenu::addActions(const QList<QAction *> &actions)
+{
+    m_model->insertActions(-1, actions);
+}
+
+void ActionListMenu::insertAction(QAction *before, QAction *action)
+{
+    m_model->insertActions(m_model->indexOf(before), {action});
+}
+
+void ActionListMenu::removeAction(QAction *action)
+{
+    m_model->removeAction(action);
+}
+
+void ActionListMenu::addSeparator()
+{
+    auto *action = new QAction(this);
+    action->setSeparator(true);
+    addAction(action);
+}
+
+void ActionListMenu::clear()
+{
+    m_model->clear();
+}
+
+void ActionListMenu::setItemHeight(int height)
+{
+    if (height == m_delegate->itemHeight()) {
+        return;
+    }
+
+    m_delegate->setItemHeight(height);
+    m_view->reset();
+    m_isWarm = false;
+}
+
+void ActionListMenu::setMaxVisibleItems(int num)
+{
+    m_maxVisibleItems = num;
+}
+
+void ActionListMenu::exec(const QPoint &pos, bool animate, Fluent::MenuAnimation aniType)
+{
+    AnimationClock::instance()->stop(m_tweenId);
+    m_tweenId = 0;
+
+    QScreen *screen = QGuiApplication::screenAt(pos);
+    if (!screen) {
+        screen = QGuiApplication::primaryScreen();
+    }
+    const QRect available = screen->availableGeometry();
+
+    // 放不下时与 RoundMenu 一样改为向另一侧弹出
+    const int chrome = kShadowTop + kShadowBottom + 2 * kViewPadding;
+    const int spaceBelow = available.bottom() - pos.y() - chrome;
+    const int spaceAbove = pos.y() - available.top() - chrome;
+    bool isPullUp = aniType == Fluent::MenuAnimation::PULL_UP || aniType == Fluent::MenuAnimation::FADE_IN_PULL_UP;
+
+    const int naturalHeight = viewHeight(qMax(spaceBelow, spaceAbove));
+    if (!isPullUp && naturalHeight > spaceBelow && spaceAbove > spaceBelow) {
+        isPullUp = true;
+    } else if (isPullUp && naturalHeight > spaceAbove && spaceBelow > spaceAbove) {
+        isPullUp = false;
+    }
+
+    const int height = qMax(0, qMin(naturalHeight, isPullUp ? spaceAbove : spaceBelow));
+    const int width = viewWidth();
+    const int windowWidth = width + kShadowLeft + kShadowRight;
+    const int windowHeight = height + chrome;
+
+    const int x = qBound(available.left(), pos.x() - kShadowLeft, qMax(available.left(), available.right() + 1 - windowWidth));
+    const int y = isPullUp ? pos.y() - windowHeight + kShadowBottom : pos.y() - kShadowTop;
+    setGeometry(x, y, windowWidth, windowHeight);
+    m_surface->setGeometry(0, 0, windowWidth, windowHeight);
+    m_view->setGeometry(kShadowLeft, kShadowTop + kViewPadding, width, height);
+
+    m_view->clearSelection();
+    m_view->setCurrentIndex(QModelIndex());
+    m_view->scrollToTop();
+
+    const MenuSlideAnimation &animation = MenuSlideAnimation::forType(
+                animate ? aniType : Fluent::MenuAnimation::NONE);
+    animation.prepare(this, m_surface);
+
+    show();
+    m_view->setFocus();
+
+    if (animation.isAnimated()) {
+        m_tweenId = animation.start(this, m_surface, isPullUp);
+    }
+}
+
+void ActionListMenu::hideMenu()
+{
+    close();
+}
+
+void ActionListMenu::warmUp()
+{
+    if (m_isWarm) {
+        return;
+    }
+
+    // 顶层窗口的 winId() 只创建原生窗口，不会显示
+    winId();
+    ensurePolished();
+    m_surface->ensurePolished();
+    m_view->ensurePolished();
+    m_view->viewport()->ensurePolished();
+
+    // doItemsLayout 在 QAbstractItemView 中是公有槽
+    static_cast<QAbstractItemView *>(m_view)->doItemsLayout();
+    viewWidth();
+    m_isWarm = true;
+}
+
+void ActionListMenu::keyPressEvent(QKeyEvent *event)
+{
+    switch (event->key()) {
+    case Qt::Key_Escape:
+        close();
+        break;
+    case Qt::Key_Enter:
+    case Qt::Key_Return:
+        triggerRow(m_view->currentIndex().row());
+        break;
+    default:
+        QWidget::keyPressEvent(event);
+        break;
+    }
+}
+
+void ActionListMenu::closeEvent(QCloseEvent *event)
+{
+    AnimationClock::instance()->stop(m_tweenId, true);
+    m_tweenId = 0;
+
+    QWidget::closeEvent(event);
+    emit closed();
+}
+
+bool ActionListMenu::eventFilter(QObject *obj, QEvent *e)
+{
+    if (obj == m_surface && e->type() == QEvent::Paint) {
+        const bool isDark = Theme::instance()->isDarkTheme();
+        const QRect rect = m_surface->rect().adjusted(kShadowLeft, kShadowTop, -kShadowRight, -kShadowBottom);
+
+        QPainter painter(m_surface);
+        painter.setRenderHints(QPainter::Antialiasing);
+        ShadowRenderer::drawShadow(&painter, rect.translated(0, kShadowOffset), kBorderRadius, kShadowBlur,
+                                   QColor(0, 0, 0, isDark ? 80 : 30));
+
+        painter.setPen(isDark ? QColor(0, 0, 0, 51) : QColor(0, 0, 0, 25));
+        painter.setBrush(isDark ? QColor(43, 43, 43) : QColor(249, 249, 249));
+        painter.drawRoundedRect(QRectF(rect).adjusted(0.5, 0.5, -0.5, -0.5), kBorderRadius, kBorderRadius);
+        return true;
+    }
+
+    return QWidget::eventFilter(obj, e);
+}
+
+int ActionListMenu::viewHeight(int maximumHeight) const
+{
+    // 只累加到最多可见项数或最大高度为止，与动作总数无关
+    int height = 0;
+    const int count = m_model->rowCount();
+    const int rows = m_maxVisibleItems > 0 ? qMin(count, m_maxVisibleItems) : count;
+    for (int row = 0; row < rows && height < maximumHeight; ++row) {
+        height += m_model->action(row)->isSeparator() ? kSeparatorHeight : m_delegate->itemHeight();
+    }
+    return qMin(height, maximumHeight);
+}
+
+int ActionListMenu::viewWidth()
+{
+    if (!m_isWidthDirty) {
+        return m_menuWidth;
+    }
+
+    // 等距抽样测量文字宽度，与之前的最大值合并；未抽到的长文字在绘制时省略
+    const int count = m_model->rowCount();
+    const int step = qMax(1, count / kWidthSampleSize);
+    const QFontMetrics metrics(m_view->font());
+    for (int row = 0; row < count; row += step) {
+        QAction *action = m_model->action(row);
+        if (action->isSeparator()) {
+            continue;
+        }
+
+        m_cachedTextWidth = qMax(m_cachedTextWidth, metrics.horizontalAdvance(action->text()));
+        if (!action->shortcut().isEmpty()) {
+            const QString shortcut = action->shortcut().toString(QKeySequence::NativeText);
+            m_cachedShortcutWidth = qMax(m_cachedShortcutWidth, metrics.horizontalAdvance(shortcut));
+        }
+    }
+
+    int width = 2 * (kItemMargin + kItemPadding) + m_cachedTextWidth;
+    if (m_model->hasIcons()) {
+        width += kIconSize + kIconSpacing;
+    }
+    if (m_cachedShortcutWidth > 0) {
+        width += kShortcutSpacing + m_cachedShortcutWidth;
+    }
+    m_menuWidth = qBound(kMinMenuWidth, width, kMaxMenuWidth);
+    m_isWidthDirty = false;
+    return m_menuWidth;
+}
+
+void ActionListMenu::triggerRow(int row)
+{
+    QAction *action = m_model->action(row);
+    if (!action || action->isSeparator() || !action->isEnabled()) {
+        return;
+    }
+
+    close();
+    action->trigger();
+    emit triggered(action);
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <QSet>
+#include <QList>
+#include <QWidget>
+#include <QListView>
+#include <QAbstractListModel>
+#include <QStyledItemDelegate>
+
+#include "FluentGlobal.h"
+#include "../Common/AnimationClock.h"
+
+class QAction;
+
+/**
+ * @brief 以 QAction 列表为数据的模型，动作本身不归模型所有
+ */
+class ActionListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Role {
+        SeparatorRole = Qt::UserRole + 1,
+        ShortcutRole
+    };
+
+    explicit ActionListModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    void insertActions(int row, const QList<QAction *> &actions);
+    void removeAction(QAction *action);
+    void clear();
+
+    QAction *action(int row) const { return row >= 0 && row < m_actions.size() ? m_actions.at(row) : nullptr; }
+    QList<QAction *> actions() const { return m_actions; }
+    int indexOf(QAction *action) const { return m_actions.indexOf(action); }
+
+    /**
+     * @brief 是否有动作带图标，用于为整列预留图标位置
+     */
+    bool hasIcons() const { return !m_iconActions.isEmpty(); }
+
+private:
+    void watch(QAction *action);
+
+    QList<QAction *> m_actions;
+    QSet<QAction *> m_iconActions;
+};
+
+/**
+ * @brief 菜单项代理，绘制与 ShortcutMenuItemDelegate 一致
+ *
+ * sizeHint 只按是否为分隔符返回高度，不测量文字；文字在绘制时才省略，
+ * 只有滚动到可见区域的项才会被测量。
+ */
+class ActionItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit ActionItemDelegate(QObject *parent = nullptr);
+
+    void setItemHeight(int height) { m_itemHeight = height; }
+    int itemHeight() const { return m_itemHeight; }
+
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+private:
+    int m_itemHeight;
+};
+
+/**
+ * @brief 虚拟化圆角菜单
+ *
+ * 接口与 RoundMenu 的动作部分一致，但动作通过 ActionListModel 交给 QListView 显示，
+ * 不为每个动作创建 QListWidgetItem。打开时只按 maxVisibleItems 计算可见行的高度，
+ * 宽度取等距抽样的动作文字宽度与之前打开时的最大值中较大者，超出的文字在绘制时省略；
+ * 删除动作或动作文字变化后最大值清零，下次打开时重新抽样，宽度可以随之收窄。
+ * 打开延迟与动作数量基本无关，适合数千项的菜单。
+ *
+ * 展开动画由 AnimationClock 推进，只移动窗口内的菜单面板，由窗口边界裁剪，不设置遮罩。
+ * 关闭只隐藏窗口，同一个实例可以反复打开；动作不变时再次打开不重新测量宽度。
+ * 不支持子菜单和嵌入控件。
+ */
+class ActionListMenu : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ActionListMenu(const QString &title = QString(), QWidget *parent = nullptr);
+
+    void addAction(QAction *action);
+    void addActions(const QList<QAction *> &actions);
+    void insertAction(QAction *before, QAction *action);
+    void removeAction(QAction *action);
+    void addSeparator();
+    void clear();
+
+    QList<QAction *> menuActions() const { return m_model->actions(); }
+
+    void setItemHeight(int height);
+    int itemHeight() const { return m_delegate->itemHeight(); }
+
+    /**
+     * @brief 最多同时显示的项数，超出后滚动，小于等于 0 时只受屏幕高度限制
+     */
+    void setMaxVisibleItems(int num);
+    int maxVisibleItems() const { return m_maxVisibleItems; }
+
+    QListView *view() const { return m_view; }
+
+    void exec(const QPoint &pos, bool animate = true,
+              Fluent::MenuAnimation aniType = Fluent::MenuAnimation::DROP_DOWN);
+    void hideMenu();
+
+    /**
+     * @brief 预热：提前创建原生窗口、计算样式、布局第一批项并测量宽度
+     *
+     * 适合在空闲时对常用菜单调用，之后第一次打开与再次打开的开销相同。
+     */
+    void warmUp();
+    bool isWarm() const { return m_isWarm; }
+
+signals:
+    void triggered(QAction *action);
+    void closed();
+
+protected:
+    void keyPressEvent(QKeyEvent *event) override;
+    void closeEvent(QCloseEvent *event) override;
+    bool eventFilter(QObject *obj, QEvent *e) override;
+
+private:
+    int viewHeight(int maximumHeight) const;
+    int viewWidth();
+    void triggerRow(int row);
+
+    QWidget *m_surface;
+    QListView *m_view;
+    ActionListModel *m_model;
+    ActionItemDelegate *m_delegate;
+
+    int m_maxVisibleItems;
+    int m_cachedTextWidth;
+    int m_cachedShortcutWidth;
+    int m_menuWidth;
+    bool m_isWidthDirty;
+    bool m_isWarm;
+    AnimationClock::TweenId m_tweenId;
+};
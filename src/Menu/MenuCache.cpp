@@ -0,0 +1,84 @@
+#include "MenuCache.h"
+
+#include <QTimer>
+#include <QWidget>
+#include <QCoreApplication>
+
+#include "ActionListMenu.h"
+
+MenuCache *MenuCache::instance()
+{
+    static MenuCache *cache = new MenuCache(QCoreApplication::instance());
+    return cache;
+}
+
+MenuCache::MenuCache(QObject *parent)
+    : QObject(parent)
+{
+}
+
+ActionListMenu *MenuCache::menu(const QString &name, QWidget *parent, const Builder &builder)
+{
+    const CacheKey key(name, parent);
+    ActionListMenu *menu = m_menus.value(key);
+    if (menu) {
+        ++m_statistics.hits;
+        return menu;
+    }
+
+    ++m_statistics.misses;
+    return create(key, builder);
+}
+
+void MenuCache::prewarm(const QString &name, QWidget *parent, const Builder &builder)
+{
+    const CacheKey key(name, parent);
+    ActionListMenu *menu = m_menus.value(key);
+    if (!menu) {
+        menu = create(key, builder);
+    }
+
+    if (!menu->isWarm()) {
+        QTimer::singleShot(0, menu, &ActionListMenu::warmUp);
+    }
+}
+
+bool MenuCache::contains(const QString &name, QWidget *parent) const
+{
+    return !m_menus.value(CacheKey(name, parent)).isNull();
+}
+
+void MenuCache::remove(const QString &name, QWidget *parent)
+{
+    QPointer<ActionListMenu> menu = m_menus.take(CacheKey(name, parent));
+    if (menu) {
+        menu->deleteLater();
+    }
+}
+
+void MenuCache::clear()
+{
+    for (const QPointer<ActionListMenu> &menu : m_menus) {
+        if (menu) {
+            menu->deleteLater();
+        }
+    }
+    m_menus.clear();
+}
+
+ActionListMenu *MenuCache::create(const CacheKey &key, const Builder &builder)
+{
+    auto menu = new ActionListMenu(QString(), key.second);
+    if (builder) {
+        builder(menu);
+    }
+
+    m_menus.insert(key, menu);
+    // remove() 之后可能已用同一个键创建了新菜单，只清理已失效的条目
+    connect(menu, &QObject::destroyed, this, [this, key]() {
+        if (m_menus.value(key).isNull()) {
+            m_menus.remove(key);
+        }
+    });
+    return menu;
+}
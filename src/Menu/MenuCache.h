@@ -0,0 +1,74 @@
+#pragma once
+
+#include <functional>
+
+#include <QHash>
+#include <QPair>
+#include <QObject>
+#include <QString>
+#include <QPointer>
+
+class QWidget;
+class ActionListMenu;
+
+/**
+ * @brief 可复用菜单的缓存
+ *
+ * 按名称和父窗口保存 ActionListMenu，第一次取用时创建并由 builder 填充动作，
+ * 之后每次打开都复用同一个实例，窗口、视图和宽度缓存都保持不变。
+ * prewarm() 在事件循环空闲时预热菜单，第一次打开也不必创建原生窗口和计算样式。
+ *
+ * 菜单归父窗口所有，父窗口销毁时一同从缓存中移除。
+ */
+class MenuCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Builder = std::function<void(ActionListMenu *menu)>;
+
+    struct Statistics {
+        qint64 hits = 0;
+        qint64 misses = 0;
+
+        qreal hitRate() const
+        {
+            const qint64 total = hits + misses;
+            return total > 0 ? qreal(hits) / total : 0;
+        }
+    };
+
+    static MenuCache *instance();
+
+    /**
+     * @brief 取出缓存的菜单，不存在时创建并调用 builder 填充
+     */
+    ActionListMenu *menu(const QString &name, QWidget *parent, const Builder &builder);
+
+    /**
+     * @brief 提前创建菜单，并在空闲时预热
+     */
+    void prewarm(const QString &name, QWidget *parent, const Builder &builder);
+
+    bool contains(const QString &name, QWidget *parent) const;
+    int count() const { return m_menus.size(); }
+
+    /**
+     * @brief 销毁菜单，下次取用时重新创建，用于动作需要整体重建的场景
+     */
+    void remove(const QString &name, QWidget *parent);
+    void clear();
+
+    Statistics statistics() const { return m_statistics; }
+    void resetStatistics() { m_statistics = Statistics(); }
+
+private:
+    using CacheKey = QPair<QString, QWidget *>;
+
+    explicit MenuCache(QObject *parent = nullptr);
+
+    ActionListMenu *create(const CacheKey &key, const Builder &builder);
+
+    QHash<CacheKey, QPointer<ActionListMenu>> m_menus;
+    Statistics m_statistics;
+};
@@ -0,0 +1,161 @@
+#include "NavigationSearchIndex.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include <QSet>
+
+namespace {
+constexpr int kGramSize = 2;
+}
+
+NavigationSearchIndex::NavigationSearchIndex()
+    : m_nextId(0)
+{
+}
+
+void NavigationSearchIndex::insert(const QString &key, const QString &text)
+{
+    remove(key);
+
+    Entry entry;
+    entry.key = key;
+    for (const QString &term : {normalize(text), normalize(key)}) {
+        if (!term.isEmpty() && !entry.terms.contains(term)) {
+            entry.terms.append(term);
+        }
+    }
+
+    // 编号只增不减，追加到倒排表末尾即可保持有序
+    const EntryId id = m_nextId++;
+    for (const QString &gram : grams(entry.terms)) {
+        m_postings[gram].append(id);
+    }
+    for (const QString &term : entry.terms) {
+        const Prefix prefix{term, id};
+        m_prefixes.insert(std::lower_bound(m_prefixes.begin(), m_prefixes.end(), prefix), prefix);
+    }
+
+    m_ids.insert(key, id);
+    m_entries.insert(id, entry);
+}
+
+void NavigationSearchIndex::remove(const QString &key)
+{
+    auto it = m_ids.find(key);
+    if (it == m_ids.end()) {
+        return;
+    }
+
+    const EntryId id = it.value();
+    const Entry entry = m_entries.take(id);
+    m_ids.erase(it);
+
+    for (const QString &gram : grams(entry.terms)) {
+        auto posting = m_postings.find(gram);
+        if (posting == m_postings.end()) {
+            continue;
+        }
+
+        auto pos = std::lower_bound(posting->begin(), posting->end(), id);
+        if (pos != posting->end() && *pos == id) {
+            posting->erase(pos);
+        }
+        if (posting->isEmpty()) {
+            m_postings.erase(posting);
+        }
+    }
+
+    for (const QString &term : entry.terms) {
+        auto pos = std::lower_bound(m_prefixes.begin(), m_prefixes.end(), Prefix{term, id});
+        if (pos != m_prefixes.end() && pos->id == id) {
+            m_prefixes.erase(pos);
+        }
+    }
+}
+
+void NavigationSearchIndex::clear()
+{
+    m_ids.clear();
+    m_entries.clear();
+    m_postings.clear();
+    m_prefixes.clear();
+}
+
+QStringList NavigationSearchIndex::search(const QString &query, int limit) const
+{
+    const QString text = normalize(query);
+    if (text.isEmpty() || limit == 0) {
+        return QStringList();
+    }
+
+    QStringList keys;
+    const auto isFull = [&]() { return limit > 0 && keys.size() >= limit; };
+
+    // 前缀匹配在有序前缀表中是连续的一段
+    QSet<EntryId> prefixIds;
+    for (auto it = std::lower_bound(m_prefixes.begin(), m_prefixes.end(), Prefix{text, -1});
+         it != m_prefixes.end() && it->term.startsWith(text) && !isFull(); ++it) {
+        if (!prefixIds.contains(it->id)) {
+            prefixIds.insert(it->id);
+            keys.append(m_entries.value(it->id).key);
+        }
+    }
+
+    if (text.size() < kGramSize || isFull()) {
+        return keys;
+    }
+
+    // 从最短的倒排表开始求交集
+    QVector<const QVector<EntryId> *> postings;
+    for (const QString &gram : grams({text})) {
+        auto it = m_postings.constFind(gram);
+        if (it == m_postings.constEnd()) {
+            return keys;
+        }
+        postings.append(&it.value());
+    }
+    std::sort(postings.begin(), postings.end(), [](const QVector<EntryId> *a, const QVector<EntryId> *b) {
+        return a->size() < b->size();
+    });
+
+    QVector<EntryId> candidates = *postings.first();
+    for (int i = 1; i < postings.size() && !candidates.isEmpty(); ++i) {
+        QVector<EntryId> intersection;
+        std::set_intersection(candidates.constBegin(), candidates.constEnd(),
+                              postings.at(i)->constBegin(), postings.at(i)->constEnd(),
+                              std::back_inserter(intersection));
+        candidates.swap(intersection);
+    }
+
+    // 二元组都出现不代表连续出现，逐项确认
+    for (EntryId id : candidates) {
+        if (isFull()) {
+            break;
+        }
+        if (prefixIds.contains(id)) {
+            continue;
+        }
+
+        const Entry &entry = *m_entries.constFind(id);
+        for (const QString &term : entry.terms) {
+            if (term.contains(text)) {
+                keys.append(entry.key);
+                break;
+            }
+        }
+    }
+
+    return keys;
+}
+
+QStringList NavigationSearchIndex::grams(const QStringList &terms)
+{
+    QSet<QString> result;
+    for (const QString &term : terms) {
+        for (int i = 0; i + kGramSize <= term.size(); ++i) {
+            result.insert(term.mid(i, kGramSize));
+        }
+    }
+    return result.values();
+}
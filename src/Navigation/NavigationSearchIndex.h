@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QHash>
+#include <QVector>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief 导航项文本与路由键的搜索索引
+ *
+ * 每一项的文本和路由键先做大小写折叠，再建立两种索引：
+ * 按词排序的前缀表，以及二元组（相邻两个字符）到项编号的有序倒排表。
+ *
+ * 单个字符的查询只走前缀表，返回以它开头的项；更长的查询对各二元组的倒排表求交集，
+ * 再逐项确认包含整个查询，前缀匹配的项排在前面。增删单项只更新该项涉及的倒排表。
+ */
+class NavigationSearchIndex
+{
+public:
+    NavigationSearchIndex();
+
+    /**
+     * @brief 添加或更新一项
+     */
+    void insert(const QString &key, const QString &text);
+    void remove(const QString &key);
+    void clear();
+
+    bool contains(const QString &key) const { return m_ids.contains(key); }
+    int size() const { return m_entries.size(); }
+
+    /**
+     * @param limit 最多返回的项数，小于 0 时不限制
+     * @return 匹配项的键，前缀匹配在前，其余按添加顺序
+     */
+    QStringList search(const QString &query, int limit = -1) const;
+
+private:
+    using EntryId = int;
+
+    struct Entry {
+        QString key;
+        QStringList terms;
+    };
+
+    struct Prefix {
+        QString term;
+        EntryId id;
+
+        bool operator<(const Prefix &other) const
+        {
+            return term != other.term ? term < other.term : id < other.id;
+        }
+    };
+
+    static QString normalize(const QString &text) { return text.trimmed().toCaseFolded(); }
+    static QStringList grams(const QStringList &terms);
+
+    QHash<QString, EntryId> m_ids;
+    QHash<EntryId, Entry> m_entries;
+    QHash<QString, QVector<EntryId>> m_postings;
+    QVector<Prefix> m_prefixes;
+    EntryId m_nextId;
+};
@@ -0,0 +1,611 @@
+#include "NavigationTreeView.h"
+
+#include <QTimer>
+#include <QEvent>
+#include <QPainter>
+#include <QScrollBar>
+#include <QMouseEvent>
+
+#include "QFluent/LineEdit.h"
+#include "QFluent/Navigation/NavigationPanel.h"
+#include "QFluent/Navigation/NavigationWidget.h"
+
+namespace {
+constexpr int kRowHeight = 36;
+constexpr int kRowSpacing = 4;
+constexpr int kIndent = 28;
+constexpr int kMaxPooledRows = 16;
+}
+
+/**
+ * @brief 导航树的一行，绘制与 NavigationTreeItem 相同，但缩进和箭头由视图绑定
+ */
+class NavigationTreeRow : public NavigationPushButton
+{
+public:
+    explicit NavigationTreeRow(QWidget *parent = nullptr)
+        : NavigationPushButton(QString(), FluentIcon(Fluent::IconType::FOLDER), true, parent)
+        , m_depth(0)
+        , m_isArrowVisible(false)
+        , m_isExpanded(false)
+    {
+    }
+
+    void setDepth(int depth)
+    {
+        if (depth != m_depth) {
+            m_depth = depth;
+            update();
+        }
+    }
+
+    void setArrowVisible(bool visible)
+    {
+        if (visible != m_isArrowVisible) {
+            m_isArrowVisible = visible;
+            update();
+        }
+    }
+
+    void setExpanded(bool isExpanded)
+    {
+        if (isExpanded != m_isExpanded) {
+            m_isExpanded = isExpanded;
+            update();
+        }
+    }
+
+    bool isArrowHit(const QPoint &pos) const
+    {
+        return m_isArrowVisible && QRect(width() - 30, 8, 20, 20).contains(pos);
+    }
+
+protected:
+    QMargins margins() const override
+    {
+        return QMargins(m_depth * kIndent, 0, m_isArrowVisible ? 20 : 0, 0);
+    }
+
+    void paintEvent(QPaintEvent *e) override
+    {
+        NavigationPushButton::paintEvent(e);
+        if (!m_isArrowVisible) {
+            return;
+        }
+
+        // 展开后箭头旋转 180°，行会被复用，不做旋转动画
+        QPainter painter(this);
+        painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
+        painter.translate(width() - 20, 18);
+        if (m_isExpanded) {
+            painter.rotate(180);
+        }
+        FluentIcon(Fluent::IconType::ARROW_DOWN).render(&painter, QRectF(-5, -5, 9.6, 9.6));
+    }
+
+private:
+    int m_depth;
+    bool m_isArrowVisible;
+    bool m_isExpanded;
+};
+
+NavigationTreeView::NavigationTreeView(QWidget *parent)
+    : ScrollArea(parent)
+    , m_view(new QWidget(this))
+    , m_nextId(1)
+    , m_currentId(0)
+    , m_isFilterDirty(false)
+    , m_isRowsDirty(false)
+    , m_isBindingDirty(false)
+    , m_isUpdatePending(false)
+    , m_isArrowClicked(false)
+{
+    setWidget(m_view);
+    setWidgetResizable(false);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    enableTransparentBackground();
+
+    connect(verticalScrollBar(), &QScrollBar::valueChanged, this, [this]() { updateRows(); });
+}
+
+void NavigationTreeView::addItem(const QString &routeKey, const FluentIconBase &icon, const QString &text,
+                                 const std::function<void()> &onClick, bool selectable,
+                                 const QString &tooltip, const QString &parentRouteKey, bool hasChildren)
+{
+    if (m_idsByKey.contains(routeKey)) {
+        throw RouteKeyError(QString("`%1` already exists.").arg(routeKey));
+    }
+
+    const NodeId parentId = idOf(parentRouteKey);
+    if (!parentRouteKey.isEmpty() && parentId == 0) {
+        throw RouteKeyError(QString("`%1` is not a valid route key.").arg(parentRouteKey));
+    }
+
+    Node node;
+    node.routeKey = routeKey;
+    node.text = text;
+    node.toolTip = tooltip;
+    node.icon.reset(icon.clone());
+    node.onClick = onClick;
+    node.isSelectable = selectable;
+    node.hasChildren = hasChildren;
+    node.isLoaded = !hasChildren;
+
+    const NodeId id = m_nextId++;
+    if (parentId != 0) {
+        Node &parent = m_nodes[parentId];
+        node.parent = parentId;
+        node.depth = parent.depth + 1;
+        parent.children.append(id);
+    } else {
+        m_roots.append(id);
+    }
+
+    m_nodes.insert(id, node);
+    m_idsByKey.insert(routeKey, id);
+    m_searchIndex.insert(routeKey, text);
+
+    // 过滤中新增的节点可能匹配，推迟到重建可见行时统一重新过滤
+    if (isFiltering()) {
+        m_isFilterDirty = true;
+        invalidateRows();
+        return;
+    }
+
+    // 折叠着的父节点下新增节点不影响可见行，只需要刷新父节点的箭头
+    if (parentId == 0 || (isRowVisible(parentId) && m_nodes.value(parentId).isExpanded)) {
+        invalidateRows();
+    } else if (NavigationTreeRow *row = m_realized.value(parentId)) {
+        row->setArrowVisible(true);
+    }
+}
+
+void NavigationTreeView::removeItem(const QString &routeKey)
+{
+    const NodeId id = idOf(routeKey);
+    if (id == 0) {
+        return;
+    }
+
+    const NodeId parentId = m_nodes.value(id).parent;
+    if (parentId != 0) {
+        m_nodes[parentId].children.removeOne(id);
+    } else {
+        m_roots.removeOne(id);
+    }
+
+    QVector<NodeId> stack{id};
+    while (!stack.isEmpty()) {
+        const NodeId current = stack.takeLast();
+        const Node node = m_nodes.take(current);
+        stack += node.children;
+
+        m_idsByKey.remove(node.routeKey);
+        m_searchIndex.remove(node.routeKey);
+        m_filterVisible.remove(current);
+        m_filterExpanded.remove(current);
+        if (NavigationTreeRow *row = m_realized.take(current)) {
+            recycleRow(row);
+        }
+        if (current == m_currentId) {
+            m_currentId = 0;
+        }
+    }
+
+    invalidateRows();
+}
+
+void NavigationTreeView::clear()
+{
+    for (NavigationTreeRow *row : m_realized) {
+        recycleRow(row);
+    }
+    m_realized.clear();
+
+    m_nodes.clear();
+    m_idsByKey.clear();
+    m_roots.clear();
+    m_currentId = 0;
+
+    m_searchIndex.clear();
+    m_filterMatches.clear();
+    m_filterVisible.clear();
+    m_filterExpanded.clear();
+    invalidateRows();
+}
+
+QString NavigationTreeView::itemText(const QString &routeKey) const
+{
+    return m_nodes.value(idOf(routeKey)).text;
+}
+
+QString NavigationTreeView::parentRouteKey(const QString &routeKey) const
+{
+    const NodeId parentId = m_nodes.value(idOf(routeKey)).parent;
+    return parentId != 0 ? m_nodes.value(parentId).routeKey : QString();
+}
+
+QStringList NavigationTreeView::childRouteKeys(const QString &routeKey) const
+{
+    QStringList routeKeys;
+    const QVector<NodeId> children = routeKey.isEmpty() ? m_roots : m_nodes.value(idOf(routeKey)).children;
+    routeKeys.reserve(children.size());
+    for (NodeId id : children) {
+        routeKeys.append(m_nodes.value(id).routeKey);
+    }
+    return routeKeys;
+}
+
+void NavigationTreeView::setExpanded(const QString &routeKey, bool isExpanded)
+{
+    const NodeId id = idOf(routeKey);
+    if (id == 0 || isNodeExpanded(id) == isExpanded) {
+        return;
+    }
+
+    // 懒加载节点第一次展开时加载子节点，加载过程中 m_nodes 会被修改，之后重新取引用
+    if (isExpanded && !m_nodes.value(id).isLoaded) {
+        m_nodes[id].isLoaded = true;
+        if (m_childrenLoader) {
+            m_childrenLoader(routeKey);
+        }
+        if (!m_nodes.contains(id)) {
+            return;
+        }
+    }
+
+    Node &node = m_nodes[id];
+    if (isExpanded && node.children.isEmpty()) {
+        node.hasChildren = false;
+        if (NavigationTreeRow *row = m_realized.value(id)) {
+            row->setArrowVisible(false);
+        }
+        return;
+    }
+
+    node.isExpanded = isExpanded;
+    if (isFiltering()) {
+        // 过滤中手动展开时显示全部子节点，折叠时同时撤销过滤带来的临时展开
+        if (isExpanded) {
+            for (NodeId child : node.children) {
+                m_filterVisible.insert(child);
+            }
+        } else {
+            m_filterExpanded.remove(id);
+        }
+    }
+    if (NavigationTreeRow *row = m_realized.value(id)) {
+        row->setExpanded(isExpanded);
+    }
+    if (isRowVisible(id)) {
+        invalidateRows();
+    }
+
+    if (isExpanded) {
+        emit itemExpanded(routeKey);
+    } else {
+        emit itemCollapsed(routeKey);
+    }
+}
+
+bool NavigationTreeView::isExpanded(const QString &routeKey) const
+{
+    return isNodeExpanded(idOf(routeKey));
+}
+
+void NavigationTreeView::setCurrentItem(const QString &routeKey)
+{
+    const NodeId id = idOf(routeKey);
+    if (id == 0 || id == m_currentId || !m_nodes.value(id).isSelectable) {
+        return;
+    }
+
+    if (NavigationTreeRow *row = m_realized.value(m_currentId)) {
+        row->setSelected(false);
+    }
+    m_currentId = id;
+    if (NavigationTreeRow *row = m_realized.value(id)) {
+        row->setSelected(true);
+    }
+
+    emit currentItemChanged(routeKey);
+}
+
+QString NavigationTreeView::currentRouteKey() const
+{
+    return m_nodes.value(m_currentId).routeKey;
+}
+
+void NavigationTreeView::ensureVisible(const QString &routeKey)
+{
+    const NodeId id = idOf(routeKey);
+    if (id == 0) {
+        return;
+    }
+
+    QVector<NodeId> ancestors;
+    for (NodeId parentId = m_nodes.value(id).parent; parentId != 0; parentId = m_nodes.value(parentId).parent) {
+        ancestors.prepend(parentId);
+    }
+    for (NodeId ancestor : ancestors) {
+        setExpanded(m_nodes.value(ancestor).routeKey, true);
+    }
+
+    if (m_isRowsDirty) {
+        rebuildRows();
+    }
+
+    const int row = m_rowIndexes.value(id, -1);
+    if (row < 0) {
+        return;
+    }
+
+    QScrollBar *scrollBar = verticalScrollBar();
+    const int top = row * kRowHeight;
+    const int viewHeight = viewport()->height();
+    if (top < scrollBar->value()) {
+        scrollBar->setValue(top);
+    } else if (top + kRowHeight > scrollBar->value() + viewHeight) {
+        scrollBar->setValue(top + kRowHeight - viewHeight);
+    }
+    updateRows();
+}
+
+void NavigationTreeView::setFilterText(const QString &text)
+{
+    const QString filterText = text.trimmed();
+    if (filterText == m_filterText) {
+        return;
+    }
+
+    m_filterText = filterText;
+    applyFilter();
+    invalidateRows();
+}
+
+void NavigationTreeView::setSearchLineEdit(SearchLineEdit *lineEdit)
+{
+    connect(lineEdit, &QLineEdit::textChanged, this, &NavigationTreeView::setFilterText);
+    connect(lineEdit, &SearchLineEdit::clearSignal, this, [this]() { setFilterText(QString()); });
+    connect(lineEdit, &SearchLineEdit::searchSignal, this, [this](const QString &text) {
+        setFilterText(text);
+        if (!m_filterMatches.isEmpty()) {
+            ensureVisible(m_filterMatches.first());
+        }
+    });
+}
+
+void NavigationTreeView::resizeEvent(QResizeEvent *event)
+{
+    ScrollArea::resizeEvent(event);
+    m_view->resize(viewport()->width(), m_view->height());
+    updateRows();
+}
+
+bool NavigationTreeView::eventFilter(QObject *obj, QEvent *e)
+{
+    // 在行发出 clicked 之前记下是否点在箭头上
+    if (e->type() == QEvent::MouseButtonRelease) {
+        auto *row = dynamic_cast<NavigationTreeRow *>(obj);
+        if (row && m_rowIds.contains(row)) {
+            m_isArrowClicked = row->isArrowHit(static_cast<QMouseEvent *>(e)->pos());
+        }
+    }
+
+    return ScrollArea::eventFilter(obj, e);
+}
+
+bool NavigationTreeView::isRowVisible(NodeId id) const
+{
+    if (!m_nodes.contains(id) || (isFiltering() && !m_filterVisible.contains(id))) {
+        return false;
+    }
+
+    for (NodeId parentId = m_nodes.constFind(id)->parent; parentId != 0; parentId = m_nodes.constFind(parentId)->parent) {
+        if (!isNodeExpanded(parentId)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool NavigationTreeView::isNodeExpanded(NodeId id) const
+{
+    auto it = m_nodes.constFind(id);
+    if (it == m_nodes.constEnd()) {
+        return false;
+    }
+    return it->isExpanded || (isFiltering() && m_filterExpanded.contains(id));
+}
+
+void NavigationTreeView::applyFilter()
+{
+    m_isFilterDirty = false;
+    m_filterVisible.clear();
+    m_filterExpanded.clear();
+    m_filterMatches.clear();
+
+    if (isFiltering()) {
+        m_filterMatches = m_searchIndex.search(m_filterText);
+    }
+
+    // 沿父节点向上标记，遇到已标记过的祖先说明更上层也已处理
+    for (const QString &routeKey : m_filterMatches) {
+        const NodeId id = idOf(routeKey);
+        m_filterVisible.insert(id);
+
+        for (NodeId parentId = m_nodes.constFind(id)->parent; parentId != 0; parentId = m_nodes.constFind(parentId)->parent) {
+            if (m_filterExpanded.contains(parentId)) {
+                break;
+            }
+            m_filterExpanded.insert(parentId);
+            m_filterVisible.insert(parentId);
+        }
+    }
+
+    emit filterChanged(m_filterMatches.size());
+}
+
+void NavigationTreeView::invalidateRows()
+{
+    m_isRowsDirty = true;
+    scheduleUpdate();
+}
+
+void NavigationTreeView::scheduleUpdate()
+{
+    // 批量添加节点时只在回到事件循环后重建一次
+    if (m_isUpdatePending) {
+        return;
+    }
+
+    m_isUpdatePending = true;
+    QTimer::singleShot(0, this, [this]() {
+        m_isUpdatePending = false;
+        updateRows();
+    });
+}
+
+void NavigationTreeView::rebuildRows()
+{
+    if (m_isFilterDirty) {
+        applyFilter();
+    }
+
+    // 只遍历展开的子树，开销与可见行数成正比，与节点总数无关
+    m_rows.clear();
+    m_rowIndexes.clear();
+
+    const bool isFiltering = this->isFiltering();
+    QVector<NodeId> stack;
+    for (int i = m_roots.size() - 1; i >= 0; --i) {
+        stack.append(m_roots.at(i));
+    }
+
+    while (!stack.isEmpty()) {
+        const NodeId id = stack.takeLast();
+        if (isFiltering && !m_filterVisible.contains(id)) {
+            continue;
+        }
+
+        const Node &node = *m_nodes.constFind(id);
+        m_rowIndexes.insert(id, m_rows.size());
+        m_rows.append(id);
+
+        if (isNodeExpanded(id)) {
+            for (int i = node.children.size() - 1; i >= 0; --i) {
+                stack.append(node.children.at(i));
+            }
+        }
+    }
+
+    m_isRowsDirty = false;
+    m_isBindingDirty = true;
+    m_view->resize(viewport()->width(), m_rows.size() * kRowHeight + kRowSpacing);
+}
+
+void NavigationTreeView::updateRows()
+{
+    if (m_isRowsDirty) {
+        rebuildRows();
+    }
+
+    const int top = verticalScrollBar()->value();
+    const int viewHeight = viewport()->height();
+
+    int first = 0;
+    int last = -1;
+    if (!m_rows.isEmpty() && viewHeight > 0) {
+        first = qBound(0, top / kRowHeight, m_rows.size() - 1);
+        last = qMin(m_rows.size() - 1, (top + viewHeight - 1) / kRowHeight);
+    }
+
+    for (auto it = m_realized.begin(); it != m_realized.end();) {
+        const int index = m_rowIndexes.value(it.key(), -1);
+        if (index >= first && index <= last) {
+            ++it;
+        } else {
+            recycleRow(it.value());
+            it = m_realized.erase(it);
+        }
+    }
+
+    // 选中、展开和箭头的变化已直接写给实例化的行，滚动时只需绑定新取出的行；
+    // 重建可见行后过滤带来的临时展开可能变化，已有的行也重新绑定一次
+    const int width = m_view->width();
+    for (int i = first; i <= last; ++i) {
+        const NodeId id = m_rows.at(i);
+        NavigationTreeRow *row = m_realized.value(id);
+        if (!row) {
+            row = acquireRow();
+            m_realized.insert(id, row);
+            m_rowIds.insert(row, id);
+            bindRow(row, id);
+        } else if (m_isBindingDirty) {
+            bindRow(row, id);
+        }
+
+        row->setGeometry(0, i * kRowHeight, width, kRowHeight);
+        row->show();
+    }
+    m_isBindingDirty = false;
+}
+
+NavigationTreeRow *NavigationTreeView::acquireRow()
+{
+    if (!m_pool.isEmpty()) {
+        return m_pool.takeLast();
+    }
+
+    auto *row = new NavigationTreeRow(m_view);
+    row->installEventFilter(this);
+    connect(row, &NavigationWidget::clicked, this, [this, row]() { onRowClicked(row); });
+
+    emit rowCreated(row);
+    return row;
+}
+
+void NavigationTreeView::recycleRow(NavigationTreeRow *row)
+{
+    m_rowIds.remove(row);
+    row->hide();
+
+    if (m_pool.size() < kMaxPooledRows) {
+        m_pool.append(row);
+    } else {
+        row->deleteLater();
+    }
+}
+
+void NavigationTreeView::bindRow(NavigationTreeRow *row, NodeId id)
+{
+    const Node &node = *m_nodes.constFind(id);
+    row->setText(node.text);
+    row->setFluentIcon(*node.icon);
+    row->setToolTip(node.toolTip);
+    row->setDepth(node.depth);
+    row->setArrowVisible(node.hasChildren || !node.children.isEmpty());
+    row->setExpanded(isNodeExpanded(id));
+    row->setSelected(id == m_currentId);
+}
+
+void NavigationTreeView::onRowClicked(NavigationTreeRow *row)
+{
+    const NodeId id = m_rowIds.value(row);
+    if (id == 0) {
+        return;
+    }
+
+    // 回调中可能增删节点，先复制
+    const Node node = m_nodes.value(id);
+    const bool isParent = node.hasChildren || !node.children.isEmpty();
+    if (isParent && (m_isArrowClicked || !node.isSelectable)) {
+        setExpanded(node.routeKey, !isNodeExpanded(id));
+        return;
+    }
+
+    setCurrentItem(node.routeKey);
+    if (node.onClick) {
+        node.onClick();
+    }
+}
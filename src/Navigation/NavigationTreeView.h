@@ -0,0 +1,177 @@
+#pragma once
+
+#include <memory>
+#include <functional>
+
+#include <QSet>
+#include <QHash>
+#include <QVector>
+#include <QStringList>
+
+#include "FluentIcon.h"
+#include "QFluent/ScrollArea.h"
+#include "NavigationSearchIndex.h"
+
+class SearchLineEdit;
+class NavigationWidget;
+class NavigationTreeRow;
+
+/**
+ * @brief 虚拟化导航树
+ *
+ * 接口与 NavigationPanel 添加树形导航项的部分一致，但节点只是轻量记录，
+ * 路由键 -> 节点都经过哈希表。只为展开且处于可见区域的行创建控件，
+ * 滚出可见区域的行回收复用，展开/折叠只重建可见行序列，不重新布局控件。
+ *
+ * 以 hasChildren 添加的节点在第一次展开时才调用 ChildrenLoader 加载子节点，
+ * 数千个节点的树启动时只需要创建根节点。
+ *
+ * 文本和路由键随增删节点增量写入 NavigationSearchIndex，setFilterText 只显示匹配项
+ * 和它们的祖先，祖先临时展开，清空过滤后恢复原来的展开状态。
+ */
+class NavigationTreeView : public ScrollArea
+{
+    Q_OBJECT
+
+public:
+    using ChildrenLoader = std::function<void(const QString &routeKey)>;
+
+    explicit NavigationTreeView(QWidget *parent = nullptr);
+
+    /**
+     * @param hasChildren 子节点由 ChildrenLoader 在第一次展开时加载
+     * @throw RouteKeyError 路由键已存在或父节点不存在
+     */
+    void addItem(const QString &routeKey,
+                 const FluentIconBase &icon,
+                 const QString &text,
+                 const std::function<void()> &onClick = nullptr,
+                 bool selectable = true,
+                 const QString &tooltip = QString(),
+                 const QString &parentRouteKey = QString(),
+                 bool hasChildren = false);
+
+    /**
+     * @brief 删除节点及其全部子孙
+     */
+    void removeItem(const QString &routeKey);
+    void clear();
+
+    void setChildrenLoader(ChildrenLoader loader) { m_childrenLoader = std::move(loader); }
+
+    bool contains(const QString &routeKey) const { return m_idsByKey.contains(routeKey); }
+    QString itemText(const QString &routeKey) const;
+    QString parentRouteKey(const QString &routeKey) const;
+    QStringList childRouteKeys(const QString &routeKey) const;
+
+    void setExpanded(const QString &routeKey, bool isExpanded);
+    bool isExpanded(const QString &routeKey) const;
+
+    void setCurrentItem(const QString &routeKey);
+    QString currentRouteKey() const;
+
+    /**
+     * @brief 展开全部祖先节点并滚动到该行
+     */
+    void ensureVisible(const QString &routeKey);
+
+    /**
+     * @brief 按文本或路由键过滤，text 为空时取消过滤
+     *
+     * 只能搜索已加载的节点，懒加载节点的子节点在第一次展开前不在索引中
+     */
+    void setFilterText(const QString &text);
+    QString filterText() const { return m_filterText; }
+    QStringList filterMatches() const { return m_filterMatches; }
+
+    /**
+     * @brief 输入时过滤，按下回车或搜索按钮时滚动到第一个匹配项
+     */
+    void setSearchLineEdit(SearchLineEdit *lineEdit);
+
+    const NavigationSearchIndex &searchIndex() const { return m_searchIndex; }
+
+    int itemCount() const { return m_nodes.size(); }
+
+    /**
+     * @brief 展开的可见行数与实例化的行控件数（含回收池），用于调试
+     */
+    int rowCount() const { return m_rows.size(); }
+    int realizedCount() const { return m_realized.size() + m_pool.size(); }
+
+signals:
+    void currentItemChanged(const QString &routeKey);
+    void itemExpanded(const QString &routeKey);
+    void itemCollapsed(const QString &routeKey);
+    void filterChanged(int matchCount);
+
+    /**
+     * @brief 新建了行控件，例如需要设置样式
+     */
+    void rowCreated(NavigationWidget *row);
+
+protected:
+    void resizeEvent(QResizeEvent *event) override;
+    bool eventFilter(QObject *obj, QEvent *e) override;
+
+private:
+    using NodeId = quint64;
+
+    struct Node {
+        QString routeKey;
+        QString text;
+        QString toolTip;
+        std::shared_ptr<FluentIconBase> icon;
+        std::function<void()> onClick;
+        NodeId parent = 0;
+        QVector<NodeId> children;
+        int depth = 0;
+        bool isSelectable = true;
+        bool hasChildren = false;
+        bool isLoaded = true;
+        bool isExpanded = false;
+    };
+
+    NodeId idOf(const QString &routeKey) const { return m_idsByKey.value(routeKey, 0); }
+    bool isRowVisible(NodeId id) const;
+    bool isNodeExpanded(NodeId id) const;
+    bool isFiltering() const { return !m_filterText.isEmpty(); }
+    void applyFilter();
+
+    void invalidateRows();
+    void scheduleUpdate();
+    void rebuildRows();
+    void updateRows();
+
+    NavigationTreeRow *acquireRow();
+    void recycleRow(NavigationTreeRow *row);
+    void bindRow(NavigationTreeRow *row, NodeId id);
+    void onRowClicked(NavigationTreeRow *row);
+
+    QWidget *m_view;
+
+    QHash<NodeId, Node> m_nodes;
+    QHash<QString, NodeId> m_idsByKey;
+    QVector<NodeId> m_roots;
+    NodeId m_nextId;
+    NodeId m_currentId;
+    ChildrenLoader m_childrenLoader;
+
+    NavigationSearchIndex m_searchIndex;
+    QString m_filterText;
+    QStringList m_filterMatches;
+    QSet<NodeId> m_filterVisible;
+    QSet<NodeId> m_filterExpanded;
+    bool m_isFilterDirty;
+
+    QVector<NodeId> m_rows;
+    QHash<NodeId, int> m_rowIndexes;
+    bool m_isRowsDirty;
+    bool m_isBindingDirty;
+    bool m_isUpdatePending;
+
+    QHash<NodeId, NavigationTreeRow *> m_realized;
+    QHash<NavigationTreeRow *, NodeId> m_rowIds;
+    QVector<NavigationTreeRow *> m_pool;
+    bool m_isArrowClicked;
+};
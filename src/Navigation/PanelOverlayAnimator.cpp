@@ -0,0 +1,132 @@
+#include "PanelOverlayAnimator.h"
+
+#include <QEvent>
+#include <QLayout>
+#include <QWidget>
+
+PanelOverlayAnimator::PanelOverlayAnimator(QWidget *panel, int collapsedWidth, int expandedWidth, QObject *parent)
+    : QObject(parent)
+    , m_panel(panel)
+    , m_placeholder(new QWidget(panel->parentWidget()))
+    , m_layer(new QWidget(panel->parentWidget()))
+    , m_collapsedWidth(qMax(0, collapsedWidth))
+    , m_expandedWidth(qMax(m_collapsedWidth, expandedWidth))
+    , m_layerWidth(m_collapsedWidth)
+    , m_isExpanded(false)
+    , m_tweenId(0)
+{
+    QWidget *host = panel->parentWidget();
+    m_placeholder->setFixedWidth(m_collapsedWidth);
+    m_placeholder->setSizePolicy(QSizePolicy::Fixed, panel->sizePolicy().verticalPolicy());
+    if (QLayout *layout = host->layout()) {
+        delete layout->replaceWidget(panel, m_placeholder);
+    }
+
+    // 覆盖层没有布局，宽度变化只裁剪面板，不影响面板内部
+    panel->setParent(m_layer);
+    panel->move(0, 0);
+    panel->setMinimumWidth(0);
+    panel->resize(m_collapsedWidth, panel->height());
+    panel->show();
+    m_layer->show();
+    m_layer->raise();
+
+    m_placeholder->installEventFilter(this);
+    syncLayer();
+}
+
+void PanelOverlayAnimator::setExpanded(bool isExpanded, bool useAnimation)
+{
+    if (isExpanded == m_isExpanded || !m_panel) {
+        return;
+    }
+
+    AnimationClock *clock = AnimationClock::instance();
+    clock->stop(m_tweenId);
+    m_tweenId = 0;
+    m_isExpanded = isExpanded;
+
+    if (isExpanded) {
+        // 面板只在开始时按展开宽度布局一次，内容区域等到结束时再变窄
+        if (m_compactHandler) {
+            m_compactHandler(false);
+        }
+        m_panel->resize(m_expandedWidth, m_placeholder->height());
+    } else {
+        m_placeholder->setFixedWidth(m_collapsedWidth);
+    }
+
+    const int targetWidth = isExpanded ? m_expandedWidth : m_collapsedWidth;
+    m_layer->raise();
+    if (!useAnimation || !m_layer->isVisible()) {
+        setLayerWidth(targetWidth);
+        finish();
+        return;
+    }
+
+    m_tweenId = clock->start(FluentAnimationType::POINT_TO_POINT, FluentAnimationSpeed::FAST,
+                             m_layerWidth, targetWidth,
+                             [this](qreal width) { setLayerWidth(qRound(width)); },
+                             nullptr, this, [this]() {
+        m_tweenId = 0;
+        finish();
+    });
+}
+
+void PanelOverlayAnimator::setExpandedWidth(int width)
+{
+    m_expandedWidth = qMax(m_collapsedWidth, width);
+    if (!m_isExpanded || m_tweenId != 0 || !m_panel) {
+        return;
+    }
+
+    m_placeholder->setFixedWidth(m_expandedWidth);
+    m_panel->resize(m_expandedWidth, m_placeholder->height());
+    setLayerWidth(m_expandedWidth);
+}
+
+bool PanelOverlayAnimator::eventFilter(QObject *obj, QEvent *e)
+{
+    if (obj == m_placeholder && (e->type() == QEvent::Move || e->type() == QEvent::Resize)) {
+        syncLayer();
+    }
+
+    return QObject::eventFilter(obj, e);
+}
+
+void PanelOverlayAnimator::setLayerWidth(int width)
+{
+    if (width == m_layerWidth) {
+        return;
+    }
+
+    m_layerWidth = width;
+    m_layer->resize(width, m_layer->height());
+}
+
+void PanelOverlayAnimator::syncLayer()
+{
+    const QRect rect = m_placeholder->geometry();
+    m_layer->setGeometry(rect.x(), rect.y(), m_layerWidth, rect.height());
+
+    // 动画中保持面板当前宽度，只同步高度
+    if (m_panel) {
+        m_panel->resize(m_panel->width(), rect.height());
+    }
+}
+
+void PanelOverlayAnimator::finish()
+{
+    if (m_isExpanded) {
+        m_placeholder->setFixedWidth(m_expandedWidth);
+    } else {
+        if (m_panel) {
+            m_panel->resize(m_collapsedWidth, m_placeholder->height());
+        }
+        if (m_compactHandler) {
+            m_compactHandler(true);
+        }
+    }
+
+    emit expandedChanged(m_isExpanded);
+}
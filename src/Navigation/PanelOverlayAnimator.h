@@ -0,0 +1,69 @@
+#pragma once
+
+#include <functional>
+
+#include <QObject>
+#include <QPointer>
+
+#include "../Common/AnimationClock.h"
+
+class QWidget;
+
+/**
+ * @brief 以覆盖层展开/折叠侧边导航面板
+ *
+ * 面板在父控件布局中的位置由一个定宽占位控件代替，面板本身放进叠在占位控件上方的覆盖层。
+ * 展开时面板先一次性设为展开宽度，动画只改变覆盖层的宽度，超出部分由覆盖层裁剪，
+ * 每帧既不重新布局面板也不重新布局旁边的内容区域。
+ *
+ * 占位控件的宽度只在展开结束或折叠开始时设置一次，内容区域每次展开/折叠只重新布局一次：
+ * 折叠时内容先变宽，面板在其上方收起，过程中不会露出空白。
+ */
+class PanelOverlayAnimator : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 面板进入或离开紧凑模式时调用，例如切换 NavigationWidget::setCompacted
+     */
+    using CompactHandler = std::function<void(bool isCompacted)>;
+
+    /**
+     * @param panel 已加入父控件布局的面板，构造后由占位控件代替
+     */
+    PanelOverlayAnimator(QWidget *panel, int collapsedWidth, int expandedWidth, QObject *parent = nullptr);
+
+    void setCompactHandler(CompactHandler handler) { m_compactHandler = std::move(handler); }
+
+    void setExpanded(bool isExpanded, bool useAnimation = true);
+    bool isExpanded() const { return m_isExpanded; }
+    void toggle() { setExpanded(!m_isExpanded); }
+
+    void setExpandedWidth(int width);
+    int expandedWidth() const { return m_expandedWidth; }
+
+    QWidget *placeholder() const { return m_placeholder; }
+
+signals:
+    void expandedChanged(bool isExpanded);
+
+protected:
+    bool eventFilter(QObject *obj, QEvent *e) override;
+
+private:
+    void setLayerWidth(int width);
+    void syncLayer();
+    void finish();
+
+    QPointer<QWidget> m_panel;
+    QWidget *m_placeholder;
+    QWidget *m_layer;
+    CompactHandler m_compactHandler;
+
+    int m_collapsedWidth;
+    int m_expandedWidth;
+    int m_layerWidth;
+    bool m_isExpanded;
+    AnimationClock::TweenId m_tweenId;
+};
@@ -0,0 +1,261 @@
+#include "PopupPool.h"
+
+#include <QEvent>
+#include <QCursor>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+
+#include "QFluent/Label.h"
+#include "QFluent/IconWidget.h"
+#include "QFluent/ToolButton.h"
+#include "../Common/TextWrapCache.h"
+#include "FluentIcon.h"
+
+namespace {
+constexpr int kFlyoutKind = 0;
+constexpr int kTeachingTipKind = 1;
+constexpr int kDefaultMaximumPoolSize = 4;
+constexpr int kWrapWidth = 60;
+}
+
+PooledFlyoutView::PooledFlyoutView(QWidget *parent)
+    : FlyoutViewBase(parent)
+    , m_viewLayout(nullptr)
+    , m_textLayout(nullptr)
+{
+    initWidget();
+    initLayout();
+}
+
+void PooledFlyoutView::initWidget()
+{
+    m_titleLabel = new StrongBodyLabel(this);
+    m_contentLabel = new BodyLabel(this);
+    m_iconWidget = new IconWidget(this);
+    m_closeButton = new TransparentToolButton(FluentIcon(Fluent::IconType::CLOSE), this);
+
+    m_iconWidget->setFixedSize(20, 20);
+    m_closeButton->setFixedSize(32, 32);
+    m_closeButton->setIconSize(QSize(12, 12));
+
+    connect(m_closeButton, &QToolButton::clicked, this, &PooledFlyoutView::closed);
+}
+
+void PooledFlyoutView::initLayout()
+{
+    m_viewLayout = new QHBoxLayout(this);
+    m_viewLayout->setContentsMargins(16, 16, 16, 16);
+    m_viewLayout->setSpacing(14);
+
+    m_textLayout = new QVBoxLayout();
+    m_textLayout->setContentsMargins(0, 0, 0, 0);
+    m_textLayout->setSpacing(4);
+    m_textLayout->addWidget(m_titleLabel);
+    m_textLayout->addWidget(m_contentLabel);
+
+    m_viewLayout->addWidget(m_iconWidget, 0, Qt::AlignTop);
+    m_viewLayout->addLayout(m_textLayout, 1);
+    m_viewLayout->addWidget(m_closeButton, 0, Qt::AlignRight | Qt::AlignTop);
+}
+
+void PooledFlyoutView::reset(const QString &title, const QString &content, const QIcon &icon, bool isClosable)
+{
+    // 与 FlyoutView::adjustText 相同按字符单位折行，复用时同样的文字直接命中缓存
+    m_titleLabel->setText(TextWrapCache::wrap(title, kWrapWidth, false).first);
+    m_contentLabel->setText(TextWrapCache::wrap(content, kWrapWidth, false).first);
+    m_titleLabel->setVisible(!title.isEmpty());
+    m_contentLabel->setVisible(!content.isEmpty());
+
+    m_iconWidget->setIcon(icon);
+    m_iconWidget->setVisible(!icon.isNull());
+
+    m_closeButton->setVisible(isClosable);
+    m_viewLayout->setContentsMargins(16, 16, isClosable ? 8 : 16, 16);
+
+    adjustSize();
+}
+
+PopupPool *PopupPool::instance()
+{
+    static PopupPool *pool = new PopupPool();
+    return pool;
+}
+
+PopupPool::PopupPool(QObject *parent)
+    : QObject(parent)
+    , m_isEnabled(false)
+    , m_maximumPoolSize(kDefaultMaximumPoolSize)
+{
+}
+
+void PopupPool::setEnabled(bool isEnabled)
+{
+    if (m_isEnabled == isEnabled) {
+        return;
+    }
+
+    m_isEnabled = isEnabled;
+    if (!m_isEnabled) {
+        clear();
+    }
+}
+
+void PopupPool::setMaximumPoolSize(int size)
+{
+    m_maximumPoolSize = qMax(0, size);
+
+    for (auto it = m_freeLists.begin(); it != m_freeLists.end(); ++it) {
+        QList<QPointer<QWidget>> &freeList = it.value();
+        while (freeList.size() > m_maximumPoolSize) {
+            QPointer<QWidget> popup = freeList.takeLast();
+            if (popup) {
+                m_teachingTipKeys.remove(popup);
+                popup->deleteLater();
+                ++m_statistics.discarded;
+            }
+        }
+    }
+}
+
+Flyout *PopupPool::flyout(const QString &title, const QString &content, const QIcon &icon,
+                          bool isClosable, QWidget *target, QWidget *parent, FlyoutAnimationType aniType)
+{
+    // 空闲的视图没有父窗口，所有 Flyout 共用一个空闲列表
+    const PoolKey key(kFlyoutKind, nullptr);
+
+    auto view = static_cast<PooledFlyoutView *>(take(key));
+    if (!view) {
+        view = new PooledFlyoutView();
+    }
+    view->reset(title, content, icon, isClosable);
+
+    // 窗口不回收：有目标时由 Flyout::make 按动画管理器定位，每次显示都会新建窗口、阴影和动画，
+    // 关闭后随之销毁
+    Flyout *flyout = nullptr;
+    if (target) {
+        flyout = Flyout::make(view, target, parent, aniType, true);
+    } else {
+        flyout = new Flyout(view, parent, true);
+        flyout->exec(QCursor::pos(), aniType);
+    }
+    connect(view, &PooledFlyoutView::closed, flyout, &QWidget::close);
+
+    // 无论是否开启都连接：关闭时由 recycle 决定回收还是销毁
+    QPointer<PooledFlyoutView> pooledView(view);
+    connect(flyout, &Flyout::closed, this, [this, key, pooledView]() {
+        if (pooledView) {
+            // 先从窗口中取出视图，窗口销毁时不会带走它
+            pooledView->setParent(nullptr);
+            recycle(key, pooledView);
+        }
+    });
+    return flyout;
+}
+
+TeachingTip *PopupPool::teachingTip(QWidget *target, const QString &title, const QString &content,
+                                    const QIcon &icon, bool isClosable, int duration,
+                                    TeachingTipTailPosition tailPosition, QWidget *parent)
+{
+    const PoolKey key(kTeachingTipKind + int(tailPosition), parent);
+
+    auto tip = static_cast<TeachingTip *>(take(key));
+    if (tip) {
+        // 箭头位置和管理器不变，只换目标和显示时长
+        tip->target = target;
+        tip->duration = duration;
+    } else {
+        auto view = new PooledFlyoutView();
+        tip = new TeachingTip(view, target, duration, tailPosition, parent, false);
+        connect(view, &PooledFlyoutView::closed, tip, &QWidget::close);
+
+        // TeachingTip 没有关闭信号，通过关闭事件回收；未开启时 recycle 直接销毁
+        m_teachingTipKeys.insert(tip, key);
+        tip->installEventFilter(this);
+        connect(tip, &QObject::destroyed, this, [this, tip]() { m_teachingTipKeys.remove(tip); });
+    }
+
+    static_cast<PooledFlyoutView *>(tip->view())->reset(title, content, icon, isClosable);
+    tip->adjustSize();
+    tip->show();
+    return tip;
+}
+
+int PopupPool::freeCount() const
+{
+    int count = 0;
+    for (const QList<QPointer<QWidget>> &freeList : m_freeLists) {
+        for (const QPointer<QWidget> &popup : freeList) {
+            if (popup) {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+void PopupPool::clear()
+{
+    for (const QList<QPointer<QWidget>> &freeList : m_freeLists) {
+        for (const QPointer<QWidget> &popup : freeList) {
+            if (popup) {
+                m_teachingTipKeys.remove(popup);
+                popup->deleteLater();
+            }
+        }
+    }
+    m_freeLists.clear();
+}
+
+void PopupPool::resetStatistics()
+{
+    m_statistics = Statistics();
+}
+
+bool PopupPool::eventFilter(QObject *obj, QEvent *e)
+{
+    // 只在关闭时回收：调用方直接 hide() 的提示可能还会再显示，不能放回空闲列表
+    if (e->type() == QEvent::Close) {
+        auto it = m_teachingTipKeys.constFind(static_cast<QWidget *>(obj));
+        if (it != m_teachingTipKeys.constEnd()) {
+            recycle(it.value(), static_cast<QWidget *>(obj));
+        }
+    }
+    return QObject::eventFilter(obj, e);
+}
+
+QWidget *PopupPool::take(const PoolKey &key)
+{
+    if (!m_isEnabled) {
+        return nullptr;
+    }
+
+    auto it = m_freeLists.find(key);
+    while (it != m_freeLists.end() && !it.value().isEmpty()) {
+        QPointer<QWidget> popup = it.value().takeLast();
+        if (popup) {
+            ++m_statistics.hits;
+            return popup;
+        }
+    }
+
+    ++m_statistics.misses;
+    return nullptr;
+}
+
+void PopupPool::recycle(const PoolKey &key, QWidget *popup)
+{
+    QList<QPointer<QWidget>> &freeList = m_freeLists[key];
+    if (freeList.contains(popup)) {
+        return;
+    }
+
+    if (!m_isEnabled || freeList.size() >= m_maximumPoolSize) {
+        m_teachingTipKeys.remove(popup);
+        popup->deleteLater();
+        ++m_statistics.discarded;
+        return;
+    }
+
+    freeList.append(popup);
+    ++m_statistics.recycled;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <QHash>
+#include <QIcon>
+#include <QList>
+#include <QPair>
+#include <QObject>
+#include <QPointer>
+
+#include "QFluent/Flyout.h"
+#include "QFluent/TeachingTip.h"
+
+class QLabel;
+class QHBoxLayout;
+class QVBoxLayout;
+class IconWidget;
+class TransparentToolButton;
+
+/**
+ * @brief 可重置内容的弹出视图
+ *
+ * 布局与 FlyoutView 一致，标题、内容、图标和关闭按钮都可以在复用时重新设置，
+ * 弹窗回收后不必重建视图。
+ */
+class PooledFlyoutView : public FlyoutViewBase
+{
+    Q_OBJECT
+
+public:
+    explicit PooledFlyoutView(QWidget *parent = nullptr);
+
+    void reset(const QString &title, const QString &content,
+               const QIcon &icon = QIcon(), bool isClosable = false);
+
+signals:
+    void closed();
+
+private:
+    void initWidget();
+    void initLayout();
+
+    QHBoxLayout *m_viewLayout;
+    QVBoxLayout *m_textLayout;
+
+    QLabel *m_titleLabel;
+    QLabel *m_contentLabel;
+    IconWidget *m_iconWidget;
+    TransparentToolButton *m_closeButton;
+};
+
+/**
+ * @brief Flyout 与 TeachingTip 的回收池（需手动开启）
+ *
+ * TeachingTip 以不随关闭销毁的方式创建，关闭后连同视图一起放回按箭头位置和父窗口区分的
+ * 空闲列表，下次通过 teachingTip() 创建时先从空闲列表中取出，只重置文字、目标和时长，
+ * 省去框架、布局、阴影和动画对象的构造与样式计算。
+ *
+ * TeachingTip 只在关闭（QEvent::Close）时回收，直接 hide() 的提示仍归调用方所有。
+ *
+ * Flyout 的定位由库中的动画管理器计算，这些类没有导出，窗口只能交给 Flyout::make 创建和定位，
+ * 因此 Flyout 窗口本身不回收，每次显示仍会新建窗口、阴影和动画对象；
+ * 池中回收的只是 PooledFlyoutView，关闭时从窗口中取出放回空闲列表，省去视图的构造和样式计算，
+ * 统计中 Flyout 的命中也只代表视图的复用。
+ *
+ * 未开启时弹窗关闭后照常销毁。
+ *
+ * InfoBar 关闭时总是自行销毁，无法回收，高频通知请配合 InfoBarQueue 限制数量。
+ */
+class PopupPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Statistics {
+        qint64 hits = 0;
+        qint64 misses = 0;
+        qint64 recycled = 0;
+        qint64 discarded = 0;
+
+        qreal hitRate() const
+        {
+            const qint64 total = hits + misses;
+            return total > 0 ? qreal(hits) / total : 0;
+        }
+    };
+
+    static PopupPool *instance();
+
+    void setEnabled(bool isEnabled);
+    bool isEnabled() const { return m_isEnabled; }
+
+    /**
+     * @brief 每种弹窗在每个父窗口下最多保留的空闲数量
+     */
+    void setMaximumPoolSize(int size);
+    int maximumPoolSize() const { return m_maximumPoolSize; }
+
+    Flyout *flyout(const QString &title,
+                   const QString &content,
+                   const QIcon &icon = QIcon(),
+                   bool isClosable = false,
+                   QWidget *target = nullptr,
+                   QWidget *parent = nullptr,
+                   FlyoutAnimationType aniType = FlyoutAnimationType::PULL_UP);
+
+    TeachingTip *teachingTip(QWidget *target,
+                             const QString &title,
+                             const QString &content,
+                             const QIcon &icon = QIcon(),
+                             bool isClosable = true,
+                             int duration = 1000,
+                             TeachingTipTailPosition tailPosition = TeachingTipTailPosition::BOTTOM,
+                             QWidget *parent = nullptr);
+
+    int freeCount() const;
+
+    /**
+     * @brief 销毁所有空闲弹窗
+     */
+    void clear();
+
+    Statistics statistics() const { return m_statistics; }
+    void resetStatistics();
+
+protected:
+    bool eventFilter(QObject *obj, QEvent *e) override;
+
+private:
+    // (弹窗类型, 父窗口)；TeachingTip 的类型包含箭头位置，管理器在构造时就已确定
+    using PoolKey = QPair<int, QWidget *>;
+
+    explicit PopupPool(QObject *parent = nullptr);
+
+    QWidget *take(const PoolKey &key);
+    void recycle(const PoolKey &key, QWidget *popup);
+
+    bool m_isEnabled;
+    int m_maximumPoolSize;
+    Statistics m_statistics;
+
+    QHash<PoolKey, QList<QPointer<QWidget>>> m_freeLists;
+    QHash<QWidget *, PoolKey> m_teachingTipKeys;
+};
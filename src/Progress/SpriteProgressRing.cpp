@@ -0,0 +1,326 @@
+#include "SpriteProgressRing.h"
+
+#include <QPen>
+#include <QHash>
+#include <QTimer>
+#include <QtMath>
+#include <QVector>
+#include <QPainter>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+
+#include "Theme.h"
+#include "../Common/AnimationGovernor.h"
+
+namespace {
+constexpr int kMaxCachedAtlases = 16;
+constexpr int kMaxAtlasWidth = 4096;
+constexpr int kDefaultSize = 80;
+constexpr int kDefaultStrokeWidth = 6;
+
+QHash<QString, QPixmap> &atlasCache()
+{
+    static QHash<QString, QPixmap> cache;
+    return cache;
+}
+
+/**
+ * @brief 所有 SpriteProgressRing 共用的帧时钟
+ *
+ * 只在有运行中的可见实例时计时，各实例按同一相位取帧。
+ */
+class ProgressRingClock : public QObject
+{
+public:
+    static ProgressRingClock *instance()
+    {
+        static ProgressRingClock *clock = new ProgressRingClock(QCoreApplication::instance());
+        return clock;
+    }
+
+    void add(SpriteProgressRing *ring)
+    {
+        if (m_rings.contains(ring)) {
+            return;
+        }
+
+        m_rings.append(ring);
+        ring->setFrame(currentFrame());
+
+        // 挂起期间不启动，恢复时再统一启动
+        if (!m_timer->isActive() && !AnimationGovernor::instance()->isSuspended()) {
+            m_timer->start();
+        }
+    }
+
+    void remove(SpriteProgressRing *ring)
+    {
+        m_rings.removeOne(ring);
+        if (m_rings.isEmpty()) {
+            m_timer->stop();
+        }
+    }
+
+private:
+    explicit ProgressRingClock(QObject *parent)
+        : QObject(parent)
+        , m_timer(new QTimer(this))
+        , m_frame(-1)
+    {
+        m_timer->setTimerType(Qt::PreciseTimer);
+        m_timer->setInterval(ProgressRingSprites::kCycleDuration / ProgressRingSprites::kFrameCount);
+        connect(m_timer, &QTimer::timeout, this, [this]() { tick(); });
+
+        // 挂起期间新加入的实例没有启动定时器，不在调度器的恢复列表中，这里补上
+        AnimationGovernor *governor = AnimationGovernor::instance();
+        governor->registerTimer(m_timer);
+        connect(governor, &AnimationGovernor::suspendedChanged, this, [this](bool isSuspended) {
+            if (!isSuspended && !m_rings.isEmpty() && !m_timer->isActive()) {
+                m_timer->start();
+            }
+        });
+        m_clock.start();
+    }
+
+    int currentFrame() const
+    {
+        const qint64 phase = m_clock.elapsed() % ProgressRingSprites::kCycleDuration;
+        return int(phase * ProgressRingSprites::kFrameCount / ProgressRingSprites::kCycleDuration);
+    }
+
+    void tick()
+    {
+        // 挂起恢复后时钟可能被重新启动，此时已没有实例
+        if (m_rings.isEmpty()) {
+            m_timer->stop();
+            return;
+        }
+
+        const int frame = currentFrame();
+        if (frame == m_frame) {
+            return;
+        }
+
+        m_frame = frame;
+        const QVector<SpriteProgressRing *> rings = m_rings;
+        for (SpriteProgressRing *ring : rings) {
+            ring->setFrame(frame);
+        }
+    }
+
+    QTimer *m_timer;
+    QElapsedTimer m_clock;
+    QVector<SpriteProgressRing *> m_rings;
+    int m_frame;
+};
+}
+
+void ProgressRingSprites::drawFrame(QPainter *painter, const QRect &rect, int strokeWidth,
+                                    const QColor &barColor, const QColor &trackColor, int frame)
+{
+    const int size = qMin(rect.width(), rect.height());
+    if (size <= 0) {
+        return;
+    }
+
+    const qreal dpr = painter->device()->devicePixelRatioF();
+    const QPixmap pixmap = atlas(size, strokeWidth, barColor, trackColor, dpr);
+
+    const int physicalSize = qCeil(size * dpr);
+    const int columns = columnCount(physicalSize);
+    const int index = qBound(0, frame, kFrameCount - 1);
+    const QRectF source((index % columns) * physicalSize, (index / columns) * physicalSize,
+                        physicalSize, physicalSize);
+
+    painter->drawPixmap(QRectF(rect.x(), rect.y(), size, size), pixmap, source);
+}
+
+QPixmap ProgressRingSprites::atlas(int size, int strokeWidth, const QColor &barColor,
+                                   const QColor &trackColor, qreal dpr)
+{
+    const QString key = QStringLiteral("%1:%2:%3:%4:%5")
+                            .arg(size)
+                            .arg(strokeWidth)
+                            .arg(barColor.rgba())
+                            .arg(trackColor.rgba())
+                            .arg(qRound(dpr * 100));
+
+    QHash<QString, QPixmap> &cache = atlasCache();
+    auto it = cache.constFind(key);
+    if (it != cache.constEnd()) {
+        return it.value();
+    }
+
+    // 单元格按物理像素对齐，避免相邻帧在缩放时互相渗透
+    const int physicalSize = qCeil(size * dpr);
+    const int columns = columnCount(physicalSize);
+    const int rows = (kFrameCount + columns - 1) / columns;
+
+    QPixmap pixmap(columns * physicalSize, rows * physicalSize);
+    pixmap.fill(Qt::transparent);
+    {
+        QPainter painter(&pixmap);
+        painter.setRenderHints(QPainter::Antialiasing);
+
+        for (int frame = 0; frame < kFrameCount; ++frame) {
+            // 前半周期起始角 0→450、跨度 0→180，后半周期起始角 450→1080、跨度 180→0
+            const qreal progress = qreal(frame) / kFrameCount * 2;
+            const bool isFirstHalf = progress < 1;
+            const qreal t = isFirstHalf ? progress : progress - 1;
+            const int startAngle = isFirstHalf ? qRound(450 * t) : qRound(450 + 630 * t);
+            const int spanAngle = isFirstHalf ? qRound(180 * t) : qRound(180 - 180 * t);
+
+            painter.save();
+            painter.translate((frame % columns) * physicalSize, (frame / columns) * physicalSize);
+            painter.setClipRect(0, 0, physicalSize, physicalSize);
+            painter.scale(dpr, dpr);
+            paintRing(&painter, size, strokeWidth, barColor, trackColor, startAngle, spanAngle);
+            painter.restore();
+        }
+    }
+    pixmap.setDevicePixelRatio(dpr);
+
+    if (cache.size() >= kMaxCachedAtlases) {
+        cache.clear();
+    }
+    cache.insert(key, pixmap);
+    return pixmap;
+}
+
+void ProgressRingSprites::clearCache()
+{
+    atlasCache().clear();
+}
+
+int ProgressRingSprites::columnCount(int physicalSize)
+{
+    return qBound(1, kMaxAtlasWidth / qMax(1, physicalSize), kFrameCount);
+}
+
+void ProgressRingSprites::paintRing(QPainter *painter, int size, int strokeWidth, const QColor &barColor,
+                                    const QColor &trackColor, int startAngle, int spanAngle)
+{
+    const qreal w = size - strokeWidth;
+    const QRectF rc(strokeWidth / 2.0, size / 2.0 - w / 2, w, w);
+
+    QPen pen(trackColor, strokeWidth, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
+    painter->setPen(pen);
+    painter->drawArc(rc, 0, 360 * 16);
+
+    pen.setColor(barColor);
+    painter->setPen(pen);
+    const int angle = -startAngle + 180;
+    painter->drawArc(rc, (angle % 360) * 16, -spanAngle * 16);
+}
+
+SpriteProgressRing::SpriteProgressRing(QWidget *parent, bool start)
+    : QProgressBar(parent)
+    , m_lightBackgroundColor(0, 0, 0, 0)
+    , m_darkBackgroundColor(0, 0, 0, 0)
+    , m_strokeWidth(kDefaultStrokeWidth)
+    , m_frame(0)
+    , m_isRunning(false)
+{
+    setTextVisible(false);
+    setFixedSize(kDefaultSize, kDefaultSize);
+
+    if (start) {
+        this->start();
+    }
+}
+
+SpriteProgressRing::~SpriteProgressRing()
+{
+    ProgressRingClock::instance()->remove(this);
+}
+
+void SpriteProgressRing::setStrokeWidth(int width)
+{
+    m_strokeWidth = width;
+    update();
+}
+
+void SpriteProgressRing::start()
+{
+    m_isRunning = true;
+    updateClockRegistration();
+}
+
+void SpriteProgressRing::stop()
+{
+    m_isRunning = false;
+    updateClockRegistration();
+
+    m_frame = 0;
+    update();
+}
+
+QColor SpriteProgressRing::lightBarColor() const
+{
+    return m_lightBarColor.isValid() ? m_lightBarColor : Theme::instance()->themeColor();
+}
+
+QColor SpriteProgressRing::darkBarColor() const
+{
+    return m_darkBarColor.isValid() ? m_darkBarColor : Theme::instance()->themeColor();
+}
+
+void SpriteProgressRing::setCustomBarColor(const QColor &light, const QColor &dark)
+{
+    m_lightBarColor = light;
+    m_darkBarColor = dark;
+    update();
+}
+
+void SpriteProgressRing::setCustomBackgroundColor(const QColor &light, const QColor &dark)
+{
+    m_lightBackgroundColor = light;
+    m_darkBackgroundColor = dark;
+    update();
+}
+
+void SpriteProgressRing::setFrame(int frame)
+{
+    if (m_frame == frame) {
+        return;
+    }
+
+    m_frame = frame;
+    update();
+}
+
+void SpriteProgressRing::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    const bool isDark = Theme::instance()->isDarkTheme();
+    const int size = qMin(width(), height());
+    const QRect rect((width() - size) / 2, (height() - size) / 2, size, size);
+
+    QPainter painter(this);
+    ProgressRingSprites::drawFrame(&painter, rect, m_strokeWidth,
+                                   isDark ? darkBarColor() : lightBarColor(),
+                                   isDark ? m_darkBackgroundColor : m_lightBackgroundColor,
+                                   m_frame);
+}
+
+void SpriteProgressRing::showEvent(QShowEvent *event)
+{
+    QProgressBar::showEvent(event);
+    updateClockRegistration();
+}
+
+void SpriteProgressRing::hideEvent(QHideEvent *event)
+{
+    QProgressBar::hideEvent(event);
+    updateClockRegistration();
+}
+
+void SpriteProgressRing::updateClockRegistration()
+{
+    if (m_isRunning && isVisible()) {
+        ProgressRingClock::instance()->add(this);
+    } else {
+        ProgressRingClock::instance()->remove(this);
+    }
+}
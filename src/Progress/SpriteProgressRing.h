@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QColor>
+#include <QPixmap>
+#include <QProgressBar>
+
+/**
+ * @brief 不定进度环的精灵图集
+ *
+ * 按 IndeterminateProgressRing 的动画（2 秒一个周期，起始角 0→450→1080、
+ * 跨度 0→180→0）把整个周期预先栅格化为 kFrameCount 帧，
+ * 图集按 (尺寸, 线宽, 颜色, 轨道颜色, 设备像素比) 缓存，绘制时只贴一帧。
+ */
+class ProgressRingSprites
+{
+public:
+    static constexpr int kFrameCount = 60;
+    static constexpr int kCycleDuration = 2000;
+
+    /**
+     * @brief 在 rect（正方形）中绘制第 frame 帧
+     */
+    static void drawFrame(QPainter *painter, const QRect &rect, int strokeWidth,
+                          const QColor &barColor, const QColor &trackColor, int frame);
+
+    static QPixmap atlas(int size, int strokeWidth, const QColor &barColor,
+                         const QColor &trackColor, qreal dpr);
+
+    static void clearCache();
+
+private:
+    ProgressRingSprites() = delete;
+
+    static int columnCount(int physicalSize);
+    static void paintRing(QPainter *painter, int size, int strokeWidth, const QColor &barColor,
+                          const QColor &trackColor, int startAngle, int spanAngle);
+};
+
+/**
+ * @brief 以精灵图集绘制的不定进度环
+ *
+ * 外观和接口与 IndeterminateProgressRing 相同，但不再为每个实例运行四个属性动画：
+ * 所有实例共用一个帧时钟，帧号变化时才逐个 update，每次绘制只是一次贴图。
+ * 只有可见且已启动的实例参与计时，窗口不可见时时钟由 AnimationGovernor 停止。
+ */
+class SpriteProgressRing : public QProgressBar
+{
+    Q_OBJECT
+    Q_PROPERTY(int strokeWidth READ strokeWidth WRITE setStrokeWidth)
+
+public:
+    explicit SpriteProgressRing(QWidget *parent = nullptr, bool start = true);
+    ~SpriteProgressRing() override;
+
+    int strokeWidth() const { return m_strokeWidth; }
+    void setStrokeWidth(int width);
+
+    void start();
+    void stop();
+    bool isRunning() const { return m_isRunning; }
+
+    QColor lightBarColor() const;
+    QColor darkBarColor() const;
+
+    void setCustomBarColor(const QColor &light, const QColor &dark);
+    void setCustomBackgroundColor(const QColor &light, const QColor &dark);
+
+    /**
+     * @brief 由共享时钟调用，帧号变化时重绘
+     */
+    void setFrame(int frame);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private:
+    void updateClockRegistration();
+
+    QColor m_lightBackgroundColor;
+    QColor m_darkBackgroundColor;
+    QColor m_lightBarColor;
+    QColor m_darkBarColor;
+    int m_strokeWidth;
+    int m_frame;
+    bool m_isRunning;
+};
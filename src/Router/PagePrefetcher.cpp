@@ -0,0 +1,184 @@
+#include "PagePrefetcher.h"
+
+#include <QTimer>
+#include <QLayout>
+#include <QWidget>
+
+#include "RouteHistory.h"
+#include "QFluent/StackedWidget.h"
+
+namespace {
+constexpr int kDefaultTimeBudget = 4;
+constexpr qreal kDefaultConfidence = 0.3;
+constexpr int kDefaultSamples = 2;
+}
+
+PagePrefetcher::PagePrefetcher(StackedWidget *stacked, QObject *parent)
+    : QObject(parent)
+    , m_stacked(stacked)
+    , m_idleTimer(new QTimer(this))
+    , m_confidence(kDefaultConfidence)
+    , m_samples(kDefaultSamples)
+    , m_timeBudget(kDefaultTimeBudget)
+{
+    // 零间隔定时器在事件队列处理完之后才触发，相当于空闲回调
+    m_idleTimer->setSingleShot(true);
+    m_idleTimer->setInterval(0);
+    connect(m_idleTimer, &QTimer::timeout, this, &PagePrefetcher::runSlice);
+
+    connect(RouteHistory::instance(), &RouteHistory::navigated, this,
+            [this](StackedWidget *stacked, const QString &from, const QString &to) {
+        if (stacked == m_stacked) {
+            recordTransition(from, to);
+        }
+    });
+}
+
+PagePrefetcher::~PagePrefetcher()
+{
+    discard(m_job);
+}
+
+void PagePrefetcher::setThreshold(qreal confidence, int samples)
+{
+    m_confidence = qBound<qreal>(0, confidence, 1);
+    m_samples = qMax(1, samples);
+}
+
+QWidget *PagePrefetcher::take(const QString &routeKey)
+{
+    if (!m_job.page || m_job.routeKey != routeKey) {
+        return nullptr;
+    }
+
+    // 仍在准备中的页面也直接交出，剩余的 polish 由正常显示流程完成
+    QWidget *page = m_job.page;
+    if (m_job.isReady) {
+        ++m_statistics.hits;
+    }
+
+    m_idleTimer->stop();
+    m_job = Job();
+    return page;
+}
+
+void PagePrefetcher::cancel()
+{
+    m_idleTimer->stop();
+    discard(m_job);
+}
+
+void PagePrefetcher::cancel(const QString &routeKey)
+{
+    if (!routeKey.isEmpty() && m_job.routeKey == routeKey) {
+        cancel();
+    }
+}
+
+void PagePrefetcher::recordTransition(const QString &from, const QString &to)
+{
+    if (!from.isEmpty() && from != to) {
+        ++m_transitions[from][to];
+        ++m_totals[from];
+    }
+
+    schedule(predict(to));
+}
+
+QString PagePrefetcher::predict(const QString &from) const
+{
+    const int total = m_totals.value(from);
+    if (total < m_samples) {
+        return QString();
+    }
+
+    QString routeKey;
+    int best = 0;
+    const QHash<QString, int> targets = m_transitions.value(from);
+    for (auto it = targets.constBegin(); it != targets.constEnd(); ++it) {
+        if (it.value() > best) {
+            best = it.value();
+            routeKey = it.key();
+        }
+    }
+
+    return best >= m_samples && qreal(best) / total >= m_confidence ? routeKey : QString();
+}
+
+void PagePrefetcher::schedule(const QString &routeKey)
+{
+    if (routeKey == m_job.routeKey && m_job.page) {
+        return;
+    }
+
+    // 新的预测替换旧的预取结果
+    m_idleTimer->stop();
+    discard(m_job);
+
+    if (routeKey.isEmpty() || !m_factory) {
+        return;
+    }
+
+    m_job.routeKey = routeKey;
+    m_idleTimer->start();
+}
+
+void PagePrefetcher::runSlice()
+{
+    if (m_job.routeKey.isEmpty() || m_job.isReady) {
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // 第一片只创建页面，创建本身无法拆分
+    if (!m_job.page) {
+        QWidget *page = m_factory(m_job.routeKey);
+        if (!page) {
+            m_job = Job();
+            return;
+        }
+
+        m_job.page = page;
+        m_job.pending.append(page);
+        const QList<QWidget *> children = page->findChildren<QWidget *>();
+        for (QWidget *child : children) {
+            m_job.pending.append(child);
+        }
+    } else {
+        while (!m_job.pending.isEmpty() && timer.elapsed() < m_timeBudget) {
+            QPointer<QWidget> widget = m_job.pending.takeFirst();
+            if (widget) {
+                widget->ensurePolished();
+            }
+        }
+
+        if (m_job.pending.isEmpty()) {
+            if (QLayout *layout = m_job.page->layout()) {
+                layout->activate();
+            }
+            m_job.isReady = true;
+            ++m_statistics.prefetched;
+        }
+    }
+
+    m_job.elapsed += timer.elapsed();
+    if (!m_job.isReady) {
+        m_idleTimer->start();
+    }
+}
+
+void PagePrefetcher::discard(Job &job)
+{
+    if (job.page) {
+        ++m_statistics.wasted;
+        m_statistics.wastedMsec += job.elapsed;
+
+        // 延迟删除前页面仍挂在页面栈下且保留 objectName，
+        // 期间 findChild 会找到它，先脱离父控件
+        job.page->setParent(nullptr);
+        job.page->deleteLater();
+    }
+    job = Job();
+}
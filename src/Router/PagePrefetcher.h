@@ -0,0 +1,103 @@
+#pragma once
+
+#include <functional>
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QElapsedTimer>
+
+class QTimer;
+class QWidget;
+class StackedWidget;
+
+/**
+ * @brief 按路由历史预取页面
+ *
+ * 统计 RouteHistory 中同一页面栈内页面之间的跳转次数，进入某个页面后，
+ * 在空闲时预先创建最可能的下一个页面并逐个 ensurePolished 其子控件。
+ * 每次空闲回调只工作 timeBudget 毫秒，工作中的预取可随时取消。
+ *
+ * 页面由 setPageFactory 提供的工厂创建，真正切换时通过 take 取走预取结果；
+ * 被新的预测替换或取消而未被使用的页面计为浪费。
+ */
+class PagePrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    using PageFactory = std::function<QWidget *(const QString &routeKey)>;
+
+    struct Statistics {
+        int prefetched = 0;
+        int hits = 0;
+        int wasted = 0;
+        qint64 wastedMsec = 0;
+
+        qreal hitRate() const { return prefetched > 0 ? qreal(hits) / prefetched : 0; }
+    };
+
+    explicit PagePrefetcher(StackedWidget *stacked, QObject *parent = nullptr);
+    ~PagePrefetcher() override;
+
+    /**
+     * @brief 页面工厂，无法或不需要创建时返回 nullptr
+     */
+    void setPageFactory(PageFactory factory) { m_factory = std::move(factory); }
+
+    void setTimeBudget(int msec) { m_timeBudget = qMax(1, msec); }
+    int timeBudget() const { return m_timeBudget; }
+
+    /**
+     * @brief 跳转概率不低于 confidence 且样本数不少于 samples 时才预取
+     */
+    void setThreshold(qreal confidence, int samples);
+
+    /**
+     * @brief 取走 routeKey 的预取页面（包括仍在准备中的），没有时返回 nullptr
+     */
+    QWidget *take(const QString &routeKey);
+
+    /**
+     * @brief 取消正在进行的预取并丢弃已准备好的页面
+     */
+    void cancel();
+
+    /**
+     * @brief 只在预取的是 routeKey 时取消，例如对应的标签被关闭
+     */
+    void cancel(const QString &routeKey);
+
+    void recordTransition(const QString &from, const QString &to);
+    QString predict(const QString &from) const;
+
+    Statistics statistics() const { return m_statistics; }
+    void resetStatistics() { m_statistics = Statistics(); }
+
+private:
+    struct Job {
+        QString routeKey;
+        QPointer<QWidget> page;
+        QList<QPointer<QWidget>> pending;
+        qint64 elapsed = 0;
+        bool isReady = false;
+    };
+
+    void schedule(const QString &routeKey);
+    void runSlice();
+    void discard(Job &job);
+
+    QPointer<StackedWidget> m_stacked;
+    PageFactory m_factory;
+    QTimer *m_idleTimer;
+
+    QHash<QString, QHash<QString, int>> m_transitions;
+    QHash<QString, int> m_totals;
+    qreal m_confidence;
+    int m_samples;
+
+    Job m_job;
+    int m_timeBudget;
+    Statistics m_statistics;
+};
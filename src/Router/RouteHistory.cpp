@@ -0,0 +1,318 @@
+#include "RouteHistory.h"
+
+#include <QCoreApplication>
+
+#include "QFluent/StackedWidget.h"
+
+namespace {
+constexpr int kDefaultMaximumHistory = 256;
+}
+
+RouteRing::RouteRing(int capacity)
+    : m_slots(qMax(1, capacity))
+    , m_head(0)
+    , m_count(0)
+    , m_liveCount(0)
+{
+}
+
+void RouteRing::setCapacity(int capacity)
+{
+    capacity = qMax(1, capacity);
+    if (capacity == m_slots.size()) {
+        return;
+    }
+
+    // 按从旧到新的顺序保留最新的 capacity 条
+    QVector<RouteItem> items;
+    items.reserve(m_liveCount);
+    for (int i = 0; i < m_count; ++i) {
+        const Entry &entry = m_slots.at(slotAt(i));
+        if (entry.isAlive) {
+            items.append(entry.item);
+        }
+    }
+
+    m_slots = QVector<Entry>(capacity);
+    m_chains.clear();
+    m_head = 0;
+    m_count = 0;
+    m_liveCount = 0;
+
+    for (int i = qMax(0, items.size() - capacity); i < items.size(); ++i) {
+        append(items.at(i));
+    }
+}
+
+bool RouteRing::push(const RouteItem &item)
+{
+    if (!isEmpty() && top().routeKey == item.routeKey) {
+        return false;
+    }
+
+    append(item);
+    return true;
+}
+
+bool RouteRing::pop(RouteItem *item)
+{
+    trimTail();
+    if (m_count == 0) {
+        return false;
+    }
+
+    const Entry &top = m_slots.at(tailSlot());
+    const QString routeKey = top.item.routeKey;
+    if (item) {
+        *item = top.item;
+    }
+
+    // 删除留下的空槽两侧可能是同键记录，它们在逻辑上是一条
+    while (m_count > 0) {
+        const int slot = tailSlot();
+        const Entry &entry = m_slots.at(slot);
+        if (entry.isAlive && entry.item.routeKey != routeKey) {
+            break;
+        }
+        if (entry.isAlive) {
+            unlink(slot);
+        }
+        --m_count;
+    }
+
+    trimTail();
+    return true;
+}
+
+int RouteRing::remove(const QString &routeKey)
+{
+    auto it = m_chains.find(routeKey);
+    if (it == m_chains.end()) {
+        return 0;
+    }
+
+    int removed = 0;
+    for (int slot = it->first; slot >= 0;) {
+        Entry &entry = m_slots[slot];
+        const int next = entry.nextSame;
+        entry.isAlive = false;
+        entry.prevSame = -1;
+        entry.nextSame = -1;
+        entry.item = RouteItem();
+        slot = next;
+        ++removed;
+    }
+
+    m_chains.erase(it);
+    m_liveCount -= removed;
+    trimTail();
+    return removed;
+}
+
+int RouteRing::remove(const StackedWidget *stacked)
+{
+    int removed = 0;
+    for (int i = 0; i < m_count; ++i) {
+        const int slot = slotAt(i);
+        if (m_slots.at(slot).isAlive && m_slots.at(slot).item.stacked == stacked) {
+            unlink(slot);
+            ++removed;
+        }
+    }
+
+    trimTail();
+    return removed;
+}
+
+RouteItem RouteRing::top() const
+{
+    // 栈顶的空槽在每次修改后都已回收，尾部一定是有效记录
+    return m_count > 0 ? m_slots.at(tailSlot()).item : RouteItem();
+}
+
+void RouteRing::clear()
+{
+    m_slots = QVector<Entry>(m_slots.size());
+    m_chains.clear();
+    m_head = 0;
+    m_count = 0;
+    m_liveCount = 0;
+}
+
+void RouteRing::append(const RouteItem &item)
+{
+    // 写满时覆盖最旧的槽位
+    if (m_count == m_slots.size()) {
+        if (m_slots.at(m_head).isAlive) {
+            unlink(m_head);
+        }
+        m_head = (m_head + 1) % m_slots.size();
+        --m_count;
+    }
+
+    const int slot = slotAt(m_count);
+    ++m_count;
+    ++m_liveCount;
+
+    Entry &entry = m_slots[slot];
+    entry.item = item;
+    entry.isAlive = true;
+    entry.nextSame = -1;
+
+    Chain &chain = m_chains[item.routeKey];
+    entry.prevSame = chain.last;
+    if (chain.last >= 0) {
+        m_slots[chain.last].nextSame = slot;
+    } else {
+        chain.first = slot;
+    }
+    chain.last = slot;
+}
+
+void RouteRing::unlink(int slot)
+{
+    Entry &entry = m_slots[slot];
+    auto it = m_chains.find(entry.item.routeKey);
+    if (it != m_chains.end()) {
+        if (entry.prevSame >= 0) {
+            m_slots[entry.prevSame].nextSame = entry.nextSame;
+        } else {
+            it->first = entry.nextSame;
+        }
+        if (entry.nextSame >= 0) {
+            m_slots[entry.nextSame].prevSame = entry.prevSame;
+        } else {
+            it->last = entry.prevSame;
+        }
+        if (it->first < 0) {
+            m_chains.erase(it);
+        }
+    }
+
+    entry.isAlive = false;
+    entry.prevSame = -1;
+    entry.nextSame = -1;
+    entry.item = RouteItem();
+    --m_liveCount;
+}
+
+void RouteRing::trimTail()
+{
+    while (m_count > 0 && !m_slots.at(tailSlot()).isAlive) {
+        --m_count;
+    }
+    if (m_count == 0) {
+        m_head = 0;
+    }
+}
+
+RouteHistory *RouteHistory::instance()
+{
+    static RouteHistory *history = new RouteHistory(QCoreApplication::instance());
+    return history;
+}
+
+RouteHistory::RouteHistory(QObject *parent)
+    : QObject(parent)
+    , m_globalHistory(kDefaultMaximumHistory)
+    , m_maximumHistory(kDefaultMaximumHistory)
+{
+}
+
+RouteHistory::~RouteHistory()
+{
+    qDeleteAll(m_stackHistories);
+}
+
+void RouteHistory::setDefaultRouteKey(StackedWidget *stacked, const QString &routeKey)
+{
+    stackedRoutes(stacked)->defaultRouteKey = routeKey;
+}
+
+void RouteHistory::push(StackedWidget *stacked, const QString &routeKey)
+{
+    StackedRoutes *routes = stackedRoutes(stacked);
+    const QString from = routes->top();
+
+    // 同一栈内不压入重复的记录
+    if (routes->history.push(RouteItem(stacked, routeKey))) {
+        m_globalHistory.push(RouteItem(stacked, routeKey));
+        emit navigated(stacked, from, routeKey);
+    }
+    emit emptyChanged(m_globalHistory.isEmpty());
+}
+
+void RouteHistory::pop()
+{
+    RouteItem item;
+    if (!m_globalHistory.pop(&item)) {
+        return;
+    }
+    emit emptyChanged(m_globalHistory.isEmpty());
+
+    StackedRoutes *routes = m_stackHistories.value(item.stacked);
+    if (!routes || routes->history.isEmpty()) {
+        return;
+    }
+
+    const QString from = routes->top();
+    routes->history.pop();
+    goToTop(item.stacked, routes);
+    emit navigated(item.stacked, from, routes->top());
+}
+
+void RouteHistory::remove(const QString &routeKey)
+{
+    m_globalHistory.remove(routeKey);
+    emit emptyChanged(m_globalHistory.isEmpty());
+
+    for (auto it = m_stackHistories.constBegin(); it != m_stackHistories.constEnd(); ++it) {
+        if (it.value()->history.remove(routeKey) > 0) {
+            goToTop(it.key(), it.value());
+        }
+    }
+}
+
+void RouteHistory::setMaximumHistory(int count)
+{
+    m_maximumHistory = qMax(1, count);
+    m_globalHistory.setCapacity(m_maximumHistory);
+    for (StackedRoutes *routes : m_stackHistories) {
+        routes->history.setCapacity(m_maximumHistory);
+    }
+}
+
+RouteHistory::StackedRoutes *RouteHistory::stackedRoutes(StackedWidget *stacked)
+{
+    StackedRoutes *routes = m_stackHistories.value(stacked);
+    if (routes) {
+        return routes;
+    }
+
+    routes = new StackedRoutes(m_maximumHistory);
+    m_stackHistories.insert(stacked, routes);
+
+    // 页面栈销毁时自动清理，不需要调用方处理
+    connect(stacked, &QObject::destroyed, this, [this, stacked]() {
+        cleanupStackedHistory(stacked);
+    });
+    return routes;
+}
+
+void RouteHistory::goToTop(StackedWidget *stacked, const StackedRoutes *routes)
+{
+    if (QWidget *widget = stacked->findChild<QWidget *>(routes->top())) {
+        stacked->setCurrentWidget(widget, false);
+    }
+}
+
+void RouteHistory::cleanupStackedHistory(StackedWidget *stacked)
+{
+    delete m_stackHistories.take(stacked);
+
+    const bool wasEmpty = m_globalHistory.isEmpty();
+    m_globalHistory.remove(stacked);
+    if (m_globalHistory.isEmpty() != wasEmpty) {
+        emit emptyChanged(m_globalHistory.isEmpty());
+    }
+}
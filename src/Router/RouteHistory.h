@@ -0,0 +1,136 @@
+#pragma once
+
+#include <QHash>
+#include <QVector>
+#include <QObject>
+
+#include "Router.h"
+
+/**
+ * @brief 定长环形路由记录
+ *
+ * 记录存放在固定容量的环形数组中，写满后覆盖最旧的一条，内存占用与会话时长无关。
+ * 同一路由键的记录通过槽位下标串成链表，按键删除只访问该键自身的记录，
+ * 被删除的记录留作空槽，在栈顶或被覆盖时回收。
+ *
+ * 与 Router 的语义一致：相邻的同键记录视为一条，压入与栈顶相同的键会被忽略，
+ * 出栈时整组弹出（对应 Router::remove 之后合并相邻重复项的效果）。
+ */
+class RouteRing
+{
+public:
+    explicit RouteRing(int capacity);
+
+    void setCapacity(int capacity);
+    int capacity() const { return m_slots.size(); }
+
+    /**
+     * @return 栈顶已是同一路由键时返回 false
+     */
+    bool push(const RouteItem &item);
+
+    /**
+     * @brief 弹出栈顶一组同键记录
+     */
+    bool pop(RouteItem *item = nullptr);
+
+    /**
+     * @return 删除的记录数
+     */
+    int remove(const QString &routeKey);
+
+    /**
+     * @brief 删除属于 stacked 的全部记录，需要遍历整个环
+     */
+    int remove(const StackedWidget *stacked);
+
+    bool contains(const QString &routeKey) const { return m_chains.contains(routeKey); }
+    RouteItem top() const;
+    bool isEmpty() const { return m_liveCount == 0; }
+    int size() const { return m_liveCount; }
+
+    /**
+     * @brief 有记录的路由键数量，不超过 size()
+     */
+    int keyCount() const { return m_chains.size(); }
+
+    void clear();
+
+private:
+    struct Entry {
+        RouteItem item;
+        int prevSame = -1;
+        int nextSame = -1;
+        bool isAlive = false;
+    };
+
+    struct Chain {
+        int first = -1;
+        int last = -1;
+    };
+
+    int slotAt(int offset) const { return (m_head + offset) % m_slots.size(); }
+    int tailSlot() const { return slotAt(m_count - 1); }
+    void append(const RouteItem &item);
+    void unlink(int slot);
+    void trimTail();
+
+    QVector<Entry> m_slots;
+    QHash<QString, Chain> m_chains;
+    int m_head;
+    int m_count;
+    int m_liveCount;
+};
+
+/**
+ * @brief 有界路由历史
+ *
+ * 接口与 Router 相同，全局历史和每个 StackedWidget 的历史都是 RouteRing，
+ * 容量由 setMaximumHistory 设置。StackedWidget 销毁时自动清理其历史记录。
+ */
+class RouteHistory : public QObject
+{
+    Q_OBJECT
+
+public:
+    static RouteHistory *instance();
+
+    void setDefaultRouteKey(StackedWidget *stacked, const QString &routeKey);
+    void push(StackedWidget *stacked, const QString &routeKey);
+    void pop();
+    void remove(const QString &routeKey);
+
+    bool isEmpty() const { return m_globalHistory.isEmpty(); }
+    int size() const { return m_globalHistory.size(); }
+
+    void setMaximumHistory(int count);
+    int maximumHistory() const { return m_maximumHistory; }
+
+signals:
+    void emptyChanged(bool empty);
+
+    /**
+     * @brief 栈内页面切换：push 成功或 pop 之后，from 为切换前的栈顶
+     */
+    void navigated(StackedWidget *stacked, const QString &from, const QString &to);
+
+private:
+    struct StackedRoutes {
+        QString defaultRouteKey;
+        RouteRing history;
+
+        explicit StackedRoutes(int capacity) : history(capacity) {}
+        QString top() const { return history.isEmpty() ? defaultRouteKey : history.top().routeKey; }
+    };
+
+    explicit RouteHistory(QObject *parent = nullptr);
+    ~RouteHistory() override;
+
+    StackedRoutes *stackedRoutes(StackedWidget *stacked);
+    void goToTop(StackedWidget *stacked, const StackedRoutes *routes);
+    void cleanupStackedHistory(StackedWidget *stacked);
+
+    RouteRing m_globalHistory;
+    QHash<StackedWidget *, StackedRoutes *> m_stackHistories;
+    int m_maximumHistory;
+};
@@ -0,0 +1,297 @@
+#include "TabSession.h"
+
+#include <functional>
+
+#include <QSaveFile>
+#include <QDataStream>
+
+namespace {
+constexpr quint32 kMagic = 0x51465453;  // "QFTS"
+constexpr quint16 kVersion = 1;
+constexpr QDataStream::Version kStreamVersion = QDataStream::Qt_5_12;
+
+// 日志超过 max(kMinCompactRecords, 标签数 * kCompactFactor) 条时压缩
+constexpr int kMinCompactRecords = 256;
+constexpr int kCompactFactor = 4;
+
+QByteArray makeRecord(const std::function<void(QDataStream &)> &write)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream.setVersion(kStreamVersion);
+    write(stream);
+    return record;
+}
+}
+
+TabSession::TabSession(const QString &filePath, QObject *parent)
+    : QObject(parent)
+    , m_filePath(filePath)
+    , m_recordCount(0)
+{
+}
+
+TabSession::~TabSession()
+{
+    m_file.close();
+}
+
+QVector<TabSession::Tab> TabSession::restore()
+{
+    m_file.close();
+    m_tabs.clear();
+    m_indexes.clear();
+    m_currentRouteKey.clear();
+
+    QFile file(m_filePath);
+    if (file.open(QIODevice::ReadOnly)) {
+        QDataStream stream(&file);
+        stream.setVersion(kStreamVersion);
+
+        quint32 magic = 0;
+        quint16 version = 0;
+        stream >> magic >> version;
+        if (stream.status() == QDataStream::Ok && magic == kMagic && version == kVersion) {
+            while (!stream.atEnd()) {
+                // 每条记录带长度前缀，读取不完整说明是被截断的尾部
+                QByteArray record;
+                stream >> record;
+                if (stream.status() != QDataStream::Ok) {
+                    break;
+                }
+                apply(record);
+            }
+        }
+        file.close();
+    }
+
+    // 回放后重写为快照，去掉作废的记录和损坏的尾部
+    compact();
+    return m_tabs;
+}
+
+QByteArray TabSession::pageState(const QString &routeKey) const
+{
+    const int index = indexOf(routeKey);
+    return index >= 0 ? m_tabs.at(index).state : QByteArray();
+}
+
+void TabSession::insertTab(int index, const Tab &tab)
+{
+    commit(makeRecord([&](QDataStream &stream) {
+        stream << quint8(Insert) << qint32(index)
+               << tab.routeKey << tab.title << tab.iconPath << tab.state;
+    }));
+}
+
+void TabSession::removeTab(const QString &routeKey)
+{
+    if (indexOf(routeKey) < 0) {
+        return;
+    }
+
+    commit(makeRecord([&](QDataStream &stream) {
+        stream << quint8(Remove) << routeKey;
+    }));
+}
+
+void TabSession::moveTab(int from, int to)
+{
+    if (from == to) {
+        return;
+    }
+
+    commit(makeRecord([&](QDataStream &stream) {
+        stream << quint8(Move) << qint32(from) << qint32(to);
+    }));
+}
+
+void TabSession::setCurrentTab(const QString &routeKey)
+{
+    if (routeKey == m_currentRouteKey) {
+        return;
+    }
+
+    commit(makeRecord([&](QDataStream &stream) {
+        stream << quint8(Current) << routeKey;
+    }));
+}
+
+void TabSession::setTabTitle(const QString &routeKey, const QString &title)
+{
+    if (indexOf(routeKey) < 0) {
+        return;
+    }
+
+    commit(makeRecord([&](QDataStream &stream) {
+        stream << quint8(Title) << routeKey << title;
+    }));
+}
+
+void TabSession::setPageState(const QString &routeKey, const QByteArray &state)
+{
+    if (indexOf(routeKey) < 0) {
+        return;
+    }
+
+    commit(makeRecord([&](QDataStream &stream) {
+        stream << quint8(State) << routeKey << state;
+    }));
+}
+
+void TabSession::compact()
+{
+    // Windows 上无法替换仍被打开的文件，先关闭日志
+    m_file.close();
+
+    QSaveFile file(m_filePath);
+    if (file.open(QIODevice::WriteOnly)) {
+        QDataStream stream(&file);
+        stream.setVersion(kStreamVersion);
+        stream << kMagic << kVersion;
+
+        for (int i = 0; i < m_tabs.size(); ++i) {
+            const Tab &tab = m_tabs.at(i);
+            stream << makeRecord([&](QDataStream &out) {
+                out << quint8(Insert) << qint32(i)
+                    << tab.routeKey << tab.title << tab.iconPath << tab.state;
+            });
+        }
+        if (!m_currentRouteKey.isEmpty()) {
+            stream << makeRecord([&](QDataStream &out) {
+                out << quint8(Current) << m_currentRouteKey;
+            });
+        }
+        file.commit();
+    }
+
+    m_recordCount = m_tabs.size() + 1;
+    openLog();
+}
+
+void TabSession::commit(const QByteArray &record)
+{
+    apply(record);
+
+    if (!m_file.isOpen() && !openLog()) {
+        return;
+    }
+
+    QDataStream stream(&m_file);
+    stream.setVersion(kStreamVersion);
+    stream << record;
+    m_file.flush();
+
+    if (++m_recordCount > qMax(kMinCompactRecords, m_tabs.size() * kCompactFactor)) {
+        compact();
+    }
+}
+
+void TabSession::apply(const QByteArray &record)
+{
+    QDataStream stream(record);
+    stream.setVersion(kStreamVersion);
+
+    quint8 operation = 0;
+    stream >> operation;
+
+    switch (operation) {
+    case Insert: {
+        qint32 index = 0;
+        Tab tab;
+        stream >> index >> tab.routeKey >> tab.title >> tab.iconPath >> tab.state;
+        if (stream.status() != QDataStream::Ok || m_indexes.contains(tab.routeKey)) {
+            break;
+        }
+
+        index = (index < 0 || index > m_tabs.size()) ? m_tabs.size() : index;
+        m_tabs.insert(index, tab);
+        reindex(index);
+        break;
+    }
+    case Remove: {
+        QString routeKey;
+        stream >> routeKey;
+
+        const int index = indexOf(routeKey);
+        if (index < 0) {
+            break;
+        }
+
+        m_tabs.remove(index);
+        m_indexes.remove(routeKey);
+        reindex(index);
+        if (m_currentRouteKey == routeKey) {
+            m_currentRouteKey.clear();
+        }
+        break;
+    }
+    case Move: {
+        qint32 from = 0;
+        qint32 to = 0;
+        stream >> from >> to;
+        if (from < 0 || to < 0 || from >= m_tabs.size() || to >= m_tabs.size()) {
+            break;
+        }
+
+        m_tabs.move(from, to);
+        reindex(qMin(from, to));
+        break;
+    }
+    case Current:
+        stream >> m_currentRouteKey;
+        break;
+    case Title: {
+        QString routeKey;
+        QString title;
+        stream >> routeKey >> title;
+
+        const int index = indexOf(routeKey);
+        if (index >= 0) {
+            m_tabs[index].title = title;
+        }
+        break;
+    }
+    case State: {
+        QString routeKey;
+        QByteArray state;
+        stream >> routeKey >> state;
+
+        const int index = indexOf(routeKey);
+        if (index >= 0) {
+            m_tabs[index].state = state;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+bool TabSession::openLog()
+{
+    m_file.setFileName(m_filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        return false;
+    }
+
+    if (m_file.size() == 0) {
+        QDataStream stream(&m_file);
+        stream.setVersion(kStreamVersion);
+        stream << kMagic << kVersion;
+        m_file.flush();
+    }
+    return true;
+}
+
+int TabSession::indexOf(const QString &routeKey) const
+{
+    return m_indexes.value(routeKey, -1);
+}
+
+void TabSession::reindex(int from)
+{
+    for (int i = qMax(0, from); i < m_tabs.size(); ++i) {
+        m_indexes.insert(m_tabs.at(i).routeKey, i);
+    }
+}
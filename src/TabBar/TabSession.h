@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QFile>
+#include <QHash>
+#include <QVector>
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+
+/**
+ * @brief 标签页会话
+ *
+ * 以追加写入的二进制操作日志记录标签的增删、移动、改名、当前标签和各页面的状态数据，
+ * 标签每次变化只追加一条记录，不重写整个文件；日志长度超过标签数的若干倍时压缩为快照。
+ * 启动时回放日志得到标签列表，末尾不完整的记录（例如写入时进程退出）会被丢弃。
+ */
+class TabSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Tab {
+        QString routeKey;
+        QString title;
+        QString iconPath;
+        QByteArray state;
+    };
+
+    explicit TabSession(const QString &filePath, QObject *parent = nullptr);
+    ~TabSession() override;
+
+    /**
+     * @brief 回放日志，返回恢复的标签；之后的记录追加在已有日志之后
+     */
+    QVector<Tab> restore();
+
+    const QVector<Tab> &tabs() const { return m_tabs; }
+    QString currentRouteKey() const { return m_currentRouteKey; }
+    QByteArray pageState(const QString &routeKey) const;
+
+    void insertTab(int index, const Tab &tab);
+    void removeTab(const QString &routeKey);
+    void moveTab(int from, int to);
+    void setCurrentTab(const QString &routeKey);
+    void setTabTitle(const QString &routeKey, const QString &title);
+    void setPageState(const QString &routeKey, const QByteArray &state);
+
+    /**
+     * @brief 立即把当前标签列表重写为快照
+     */
+    void compact();
+
+private:
+    enum Operation : quint8 {
+        Insert = 1,
+        Remove,
+        Move,
+        Current,
+        Title,
+        State
+    };
+
+    void commit(const QByteArray &record);
+    void apply(const QByteArray &record);
+    bool openLog();
+    int indexOf(const QString &routeKey) const;
+    void reindex(int from);
+
+    QString m_filePath;
+    QFile m_file;
+    QVector<Tab> m_tabs;
+    QHash<QString, int> m_indexes;
+    QString m_currentRouteKey;
+    int m_recordCount;
+};
@@ -0,0 +1,695 @@
+#include "VirtualTabBar.h"
+
+#include <QSet>
+#include <QEvent>
+#include <QWheelEvent>
+#include <QMouseEvent>
+
+#include "FluentIcon.h"
+
+namespace {
+constexpr int kTabHeight = 36;
+constexpr int kMargin = 5;
+constexpr int kAddButtonWidth = 32;
+constexpr int kAddButtonHeight = 24;
+constexpr int kAddButtonSpacing = 4;
+constexpr int kDefaultTabMaxWidth = 240;
+constexpr int kDefaultTabMinWidth = 64;
+constexpr int kMaxPooledItems = 8;
+constexpr int kSlideDuration = 250;
+}
+
+VirtualTabBar::VirtualTabBar(QWidget *parent)
+    : QWidget(parent)
+    , m_view(new QWidget(this))
+    , m_addButton(new TransparentToolButton(FluentIcon(Fluent::IconType::ADD), this))
+    , m_nextId(1)
+    , m_currentIndex(-1)
+    , m_scrollOffset(0)
+    , m_tabMaxWidth(kDefaultTabMaxWidth)
+    , m_tabMinWidth(kDefaultTabMinWidth)
+    , m_isMovable(false)
+    , m_isScrollable(false)
+    , m_isTabShadowEnabled(true)
+    , m_isDragging(false)
+    , m_dragX(0)
+    , m_closeButtonDisplayMode(TabCloseButtonDisplayMode::Always)
+{
+    setFixedHeight(kTabHeight + 2 * kMargin);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+
+    // TabItem 会把鼠标事件转发给父控件，拖动已由事件过滤器处理，转发的事件在这里截止
+    m_view->setAttribute(Qt::WA_NoMousePropagation);
+
+    m_addButton->setFixedSize(kAddButtonWidth, kAddButtonHeight);
+    m_addButton->setIconSize(QSize(12, 12));
+    connect(m_addButton, &TransparentToolButton::clicked, this, &VirtualTabBar::tabAddRequested);
+}
+
+void VirtualTabBar::setAddButtonVisible(bool visible)
+{
+    m_addButton->setVisible(visible);
+    updateLayout();
+}
+
+int VirtualTabBar::addTab(const QString &routeKey, const QString &text, const QIcon &icon,
+                          std::function<void()> onClick)
+{
+    return insertTab(-1, routeKey, text, icon, std::move(onClick));
+}
+
+int VirtualTabBar::insertTab(int index, const QString &routeKey, const QString &text, const QIcon &icon,
+                             std::function<void()> onClick)
+{
+    if (index < 0 || index > m_tabs.size()) {
+        index = m_tabs.size();
+    }
+
+    TabRecord record;
+    record.id = m_nextId++;
+    record.routeKey = routeKey;
+    record.text = text;
+    record.icon = icon;
+    record.onClick = std::move(onClick);
+    m_tabs.insert(index, record);
+    m_idsByKey.insert(routeKey, record.id);
+    reindex(index);
+
+    if (m_currentIndex >= index) {
+        ++m_currentIndex;
+    }
+
+    if (m_tabs.size() == 1) {
+        setCurrentIndex(0);
+    } else {
+        updateLayout();
+    }
+    updateGeometry();
+    return index;
+}
+
+void VirtualTabBar::removeTab(int index)
+{
+    if (index < 0 || index >= m_tabs.size()) {
+        return;
+    }
+
+    const TabRecord record = m_tabs.at(index);
+    if (TabItem *item = m_realized.take(record.id)) {
+        recycleItem(item);
+    }
+    AnimationClock::instance()->stop(m_slides.take(record.id).tweenId);
+    if (m_idsByKey.value(record.routeKey) == record.id) {
+        m_idsByKey.remove(record.routeKey);
+    }
+    m_positions.remove(record.id);
+
+    // 拖动中删除标签时结束拖动，避免松开鼠标时按失效的 m_currentIndex 归位
+    const bool isDraggingOther = m_isDragging && index != m_currentIndex;
+    m_isDragging = false;
+
+    // 记下右侧已实例化标签的当前位置，删除后从这里滑到新位置
+    QHash<TabId, int> oldX;
+    for (auto it = m_realized.constBegin(); it != m_realized.constEnd(); ++it) {
+        const int position = indexOfId(it.key());
+        if (position > index) {
+            oldX.insert(it.key(), displayX(position));
+        }
+    }
+
+    m_tabs.remove(index);
+    reindex(index);
+
+    const int width = tabWidth();
+    for (auto it = oldX.constBegin(); it != oldX.constEnd(); ++it) {
+        slideTab(it.key(), it.value(), indexOfId(it.key()) * width, kSlideDuration);
+    }
+
+    // 与 TabBar 一致：关闭当前标签后选中左侧标签，关闭第一个时选中新的第一个
+    if (index < m_currentIndex) {
+        --m_currentIndex;
+    } else if (index == m_currentIndex) {
+        m_currentIndex = -1;
+        if (!m_tabs.isEmpty()) {
+            setCurrentIndex(qMax(0, index - 1));
+        } else {
+            emit currentChanged(-1);
+        }
+    }
+
+    // 被拖动的标签仍在时，从松手前的位置滑回它的槽位
+    if (isDraggingOther && m_currentIndex >= 0) {
+        slideTab(m_tabs.at(m_currentIndex).id, m_dragX, m_currentIndex * width, kSlideDuration);
+    }
+
+    updateLayout();
+    updateGeometry();
+}
+
+void VirtualTabBar::removeTabByKey(const QString &routeKey)
+{
+    removeTab(indexOf(routeKey));
+}
+
+void VirtualTabBar::setCurrentIndex(int index)
+{
+    if (index < 0 || index >= m_tabs.size() || index == m_currentIndex) {
+        return;
+    }
+
+    m_currentIndex = index;
+    ensureVisible(index);
+    updateLayout();
+    emit currentChanged(index);
+}
+
+void VirtualTabBar::setCurrentTab(const QString &routeKey)
+{
+    setCurrentIndex(indexOf(routeKey));
+}
+
+QString VirtualTabBar::currentRouteKey() const
+{
+    return routeKey(m_currentIndex);
+}
+
+int VirtualTabBar::indexOf(const QString &routeKey) const
+{
+    auto it = m_idsByKey.constFind(routeKey);
+    return it != m_idsByKey.constEnd() ? indexOfId(it.value()) : -1;
+}
+
+QString VirtualTabBar::routeKey(int index) const
+{
+    return index >= 0 && index < m_tabs.size() ? m_tabs.at(index).routeKey : QString();
+}
+
+TabItem *VirtualTabBar::tabItem(int index) const
+{
+    return realizedItem(index);
+}
+
+TabItem *VirtualTabBar::tab(const QString &routeKey) const
+{
+    return realizedItem(indexOf(routeKey));
+}
+
+TabItem *VirtualTabBar::currentTab() const
+{
+    return realizedItem(m_currentIndex);
+}
+
+QRect VirtualTabBar::tabRect(int index) const
+{
+    const int width = tabWidth();
+    return QRect(index * width, 0, width, kTabHeight);
+}
+
+void VirtualTabBar::ensureVisible(int index)
+{
+    if (index < 0 || index >= m_tabs.size()) {
+        return;
+    }
+
+    const QRect rect = tabRect(index);
+    if (rect.left() < m_scrollOffset) {
+        setScrollOffset(rect.left());
+    } else if (rect.right() >= m_scrollOffset + viewportWidth()) {
+        setScrollOffset(rect.right() + 1 - viewportWidth());
+    }
+}
+
+QString VirtualTabBar::tabText(int index) const
+{
+    return index >= 0 && index < m_tabs.size() ? m_tabs.at(index).text : QString();
+}
+
+QIcon VirtualTabBar::tabIcon(int index) const
+{
+    return index >= 0 && index < m_tabs.size() ? m_tabs.at(index).icon : QIcon();
+}
+
+QString VirtualTabBar::tabToolTip(int index) const
+{
+    return index >= 0 && index < m_tabs.size() ? m_tabs.at(index).toolTip : QString();
+}
+
+void VirtualTabBar::setTabText(int index, const QString &text)
+{
+    if (index < 0 || index >= m_tabs.size()) {
+        return;
+    }
+
+    m_tabs[index].text = text;
+    if (TabItem *item = realizedItem(index)) {
+        item->setText(text);
+    }
+}
+
+void VirtualTabBar::setTabIcon(int index, const QIcon &icon)
+{
+    if (index < 0 || index >= m_tabs.size()) {
+        return;
+    }
+
+    m_tabs[index].icon = icon;
+    if (TabItem *item = realizedItem(index)) {
+        item->setIcon(icon);
+    }
+}
+
+void VirtualTabBar::setTabToolTip(int index, const QString &toolTip)
+{
+    if (index < 0 || index >= m_tabs.size()) {
+        return;
+    }
+
+    m_tabs[index].toolTip = toolTip;
+    if (TabItem *item = realizedItem(index)) {
+        item->setToolTip(toolTip);
+    }
+}
+
+void VirtualTabBar::setTabTextColor(int index, const QColor &color)
+{
+    if (index < 0 || index >= m_tabs.size()) {
+        return;
+    }
+
+    m_tabs[index].textColor = color;
+    if (TabItem *item = realizedItem(index)) {
+        item->setTextColor(color);
+    }
+}
+
+void VirtualTabBar::setTabSelectedBackgroundColor(const QColor &light, const QColor &dark)
+{
+    m_lightSelectedBackgroundColor = light;
+    m_darkSelectedBackgroundColor = dark;
+
+    for (TabItem *item : m_realized) {
+        item->setSelectedBackgroundColor(light, dark);
+    }
+    for (TabItem *item : m_pool) {
+        item->setSelectedBackgroundColor(light, dark);
+    }
+}
+
+void VirtualTabBar::setCloseButtonDisplayMode(TabCloseButtonDisplayMode mode)
+{
+    m_closeButtonDisplayMode = mode;
+
+    for (TabItem *item : m_realized) {
+        item->setCloseButtonDisplayMode(mode);
+    }
+    for (TabItem *item : m_pool) {
+        item->setCloseButtonDisplayMode(mode);
+    }
+}
+
+void VirtualTabBar::setTabsClosable(bool closable)
+{
+    setCloseButtonDisplayMode(closable ? TabCloseButtonDisplayMode::Always : TabCloseButtonDisplayMode::Never);
+}
+
+void VirtualTabBar::setTabShadowEnabled(bool enabled)
+{
+    m_isTabShadowEnabled = enabled;
+
+    for (TabItem *item : m_realized) {
+        item->setShadowEnabled(enabled);
+    }
+    for (TabItem *item : m_pool) {
+        item->setShadowEnabled(enabled);
+    }
+}
+
+void VirtualTabBar::setScrollable(bool scrollable)
+{
+    m_isScrollable = scrollable;
+    updateLayout();
+}
+
+void VirtualTabBar::setTabMaximumWidth(int width)
+{
+    m_tabMaxWidth = qMax(1, width);
+    m_tabMinWidth = qMin(m_tabMinWidth, m_tabMaxWidth);
+    updateLayout();
+    updateGeometry();
+}
+
+void VirtualTabBar::setTabMinimumWidth(int width)
+{
+    m_tabMinWidth = qBound(1, width, m_tabMaxWidth);
+    updateLayout();
+    updateGeometry();
+}
+
+QSize VirtualTabBar::sizeHint() const
+{
+    const int buttonWidth = m_addButton->isVisibleTo(this) ? kAddButtonWidth + kAddButtonSpacing : 0;
+    return QSize(2 * kMargin + m_tabs.size() * m_tabMaxWidth + buttonWidth, kTabHeight + 2 * kMargin);
+}
+
+QSize VirtualTabBar::minimumSizeHint() const
+{
+    return QSize(2 * kMargin + kAddButtonWidth, kTabHeight + 2 * kMargin);
+}
+
+void VirtualTabBar::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    updateLayout();
+}
+
+void VirtualTabBar::wheelEvent(QWheelEvent *event)
+{
+    const QPoint delta = event->angleDelta();
+    setScrollOffset(m_scrollOffset - (delta.x() != 0 ? delta.x() : delta.y()));
+    event->accept();
+}
+
+bool VirtualTabBar::eventFilter(QObject *obj, QEvent *e)
+{
+    TabItem *item = qobject_cast<TabItem *>(obj);
+    if (!item || !m_itemIds.contains(item)) {
+        return QWidget::eventFilter(obj, e);
+    }
+
+    switch (e->type()) {
+    case QEvent::MouseButtonPress: {
+        auto *event = static_cast<QMouseEvent *>(e);
+        if (event->button() == Qt::LeftButton) {
+            m_dragPos = item->mapTo(m_view, event->pos());
+        }
+        break;
+    }
+    case QEvent::MouseMove: {
+        auto *event = static_cast<QMouseEvent *>(e);
+        if (event->buttons() & Qt::LeftButton) {
+            dragTo(item->mapTo(m_view, event->pos()));
+        }
+        break;
+    }
+    case QEvent::MouseButtonRelease:
+        if (m_isDragging && m_currentIndex >= 0 && m_currentIndex < m_tabs.size()) {
+            // 与 TabItem::slideTo 相同，时长按剩余距离折算
+            const int width = tabWidth();
+            const int targetX = m_currentIndex * width;
+            const int duration = qAbs(m_dragX - targetX) * kSlideDuration / qMax(1, width);
+
+            m_isDragging = false;
+            slideTab(m_tabs.at(m_currentIndex).id, m_dragX, targetX, duration);
+            updateLayout();
+        } else {
+            m_isDragging = false;
+        }
+        break;
+    default:
+        break;
+    }
+
+    return QWidget::eventFilter(obj, e);
+}
+
+int VirtualTabBar::tabWidth() const
+{
+    if (m_isScrollable || m_tabs.isEmpty()) {
+        return m_tabMaxWidth;
+    }
+
+    // 不可滚动时标签先收窄到最小宽度，再不够才出现滚动
+    return qBound(m_tabMinWidth, viewportWidth() / m_tabs.size(), m_tabMaxWidth);
+}
+
+int VirtualTabBar::viewportWidth() const
+{
+    const int buttonWidth = m_addButton->isVisibleTo(this) ? kAddButtonWidth + kAddButtonSpacing : 0;
+    return qMax(0, width() - 2 * kMargin - buttonWidth);
+}
+
+int VirtualTabBar::contentWidth() const
+{
+    return m_tabs.size() * tabWidth();
+}
+
+void VirtualTabBar::setScrollOffset(int offset)
+{
+    offset = qBound(0, offset, qMax(0, contentWidth() - viewportWidth()));
+    if (offset == m_scrollOffset) {
+        return;
+    }
+
+    m_scrollOffset = offset;
+    updateLayout();
+}
+
+void VirtualTabBar::updateLayout()
+{
+    const int width = tabWidth();
+    const int viewWidth = viewportWidth();
+    m_view->setGeometry(kMargin, kMargin, viewWidth, kTabHeight);
+    m_scrollOffset = qBound(0, m_scrollOffset, qMax(0, contentWidth() - viewWidth));
+
+    // 可见区间由偏移量直接算出；拖动中的标签即使滚出可见区域也保留
+    int first = 0;
+    int last = -1;
+    if (!m_tabs.isEmpty() && viewWidth > 0) {
+        first = m_scrollOffset / width;
+        last = qMin(m_tabs.size() - 1, (m_scrollOffset + viewWidth - 1) / width);
+    }
+
+    QSet<TabId> visibleIds;
+    for (int i = first; i <= last; ++i) {
+        visibleIds.insert(m_tabs.at(i).id);
+    }
+    const bool isDraggingCurrent = m_isDragging && m_currentIndex >= 0;
+    if (isDraggingCurrent) {
+        visibleIds.insert(m_tabs.at(m_currentIndex).id);
+    }
+
+    for (auto it = m_realized.begin(); it != m_realized.end();) {
+        if (visibleIds.contains(it.key())) {
+            ++it;
+        } else {
+            recycleItem(it.value());
+            it = m_realized.erase(it);
+        }
+    }
+
+    const auto place = [&](int index) {
+        const TabRecord &record = m_tabs.at(index);
+        TabItem *item = m_realized.value(record.id);
+        if (!item) {
+            item = acquireItem();
+            bindItem(item, record);
+            m_realized.insert(record.id, item);
+            m_itemIds.insert(item, record.id);
+        }
+
+        item->setGeometry(displayX(index) - m_scrollOffset, 0, width, kTabHeight);
+        item->setSelected(index == m_currentIndex);
+        item->show();
+    };
+
+    for (int i = first; i <= last; ++i) {
+        place(i);
+    }
+    if (isDraggingCurrent && (m_currentIndex < first || m_currentIndex > last)) {
+        place(m_currentIndex);
+    }
+    if (TabItem *item = realizedItem(m_currentIndex)) {
+        item->raise();
+    }
+
+    const int buttonX = kMargin + qMin(contentWidth() - m_scrollOffset, viewWidth) + kAddButtonSpacing;
+    m_addButton->move(buttonX, (height() - kAddButtonHeight) / 2);
+}
+
+TabItem *VirtualTabBar::acquireItem()
+{
+    if (!m_pool.isEmpty()) {
+        return m_pool.takeLast();
+    }
+
+    TabItem *item = new TabItem(QString(), m_view);
+    item->setMinimumWidth(0);
+    item->setMaximumWidth(QWIDGETSIZE_MAX);
+    item->setShadowEnabled(m_isTabShadowEnabled);
+    item->setCloseButtonDisplayMode(m_closeButtonDisplayMode);
+    if (m_lightSelectedBackgroundColor.isValid()) {
+        item->setSelectedBackgroundColor(m_lightSelectedBackgroundColor, m_darkSelectedBackgroundColor);
+    }
+    item->installEventFilter(this);
+
+    connect(item, &QPushButton::pressed, this, [this, item]() { onItemPressed(item); });
+    connect(item, &TabItem::closed, this, [this, item]() {
+        const int index = indexOfId(m_itemIds.value(item));
+        if (index >= 0) {
+            emit tabCloseRequested(index);
+        }
+    });
+
+    emit itemCreated(item);
+    return item;
+}
+
+void VirtualTabBar::recycleItem(TabItem *item)
+{
+    m_itemIds.remove(item);
+    item->hide();
+
+    if (m_pool.size() < kMaxPooledItems) {
+        m_pool.append(item);
+    } else {
+        item->deleteLater();
+    }
+}
+
+void VirtualTabBar::bindItem(TabItem *item, const TabRecord &record)
+{
+    item->setRouteKey(record.routeKey);
+    item->setText(record.text);
+    item->setIcon(record.icon);
+    item->setToolTip(record.toolTip);
+    item->setTextColor(record.textColor);
+}
+
+TabItem *VirtualTabBar::realizedItem(int index) const
+{
+    if (index < 0 || index >= m_tabs.size()) {
+        return nullptr;
+    }
+    return m_realized.value(m_tabs.at(index).id);
+}
+
+int VirtualTabBar::indexOfId(TabId id) const
+{
+    return m_positions.value(id, -1);
+}
+
+void VirtualTabBar::reindex(int from)
+{
+    for (int i = qMax(0, from); i < m_tabs.size(); ++i) {
+        m_positions.insert(m_tabs.at(i).id, i);
+    }
+}
+
+int VirtualTabBar::displayX(int index) const
+{
+    if (m_isDragging && index == m_currentIndex) {
+        return m_dragX;
+    }
+
+    auto it = m_slides.constFind(m_tabs.at(index).id);
+    return it != m_slides.constEnd() ? qRound(it->x) : index * tabWidth();
+}
+
+void VirtualTabBar::slideTab(TabId id, int fromX, int toX, int duration)
+{
+    AnimationClock *clock = AnimationClock::instance();
+    clock->stop(m_slides.take(id).tweenId);
+    if (fromX == toX || duration <= 0) {
+        return;
+    }
+
+    AnimationClock::Spec spec;
+    spec.duration = duration;
+
+    // 只移动对应的 TabItem，不重新计算整条标签栏
+    m_slides[id].x = fromX;
+    const AnimationClock::TweenId tweenId = clock->start(fromX, toX, spec, [this, id](qreal x) {
+        auto it = m_slides.find(id);
+        if (it == m_slides.end()) {
+            return;
+        }
+
+        it->x = x;
+        if (TabItem *item = m_realized.value(id)) {
+            item->move(qRound(x) - m_scrollOffset, 0);
+        }
+    }, nullptr, this, [this, id]() {
+        m_slides.remove(id);
+    });
+
+    auto it = m_slides.find(id);
+    if (it != m_slides.end()) {
+        it->tweenId = tweenId;
+    }
+}
+
+void VirtualTabBar::onItemPressed(TabItem *item)
+{
+    const TabId id = m_itemIds.value(item);
+    int index = indexOfId(id);
+    if (index < 0) {
+        return;
+    }
+
+    // currentChanged、tabBarClicked 的槽中可能增删或移动标签：
+    // 先复制回调，每次发出信号后按编号重新定位，标签已被移除时不再继续
+    const std::function<void()> onClick = m_tabs.at(index).onClick;
+
+    setCurrentIndex(index);
+    index = indexOfId(id);
+    if (index < 0) {
+        return;
+    }
+
+    emit tabBarClicked(index);
+    if (onClick && indexOfId(id) >= 0) {
+        onClick();
+    }
+}
+
+void VirtualTabBar::dragTo(const QPoint &pos)
+{
+    if (!m_isMovable || m_tabs.size() < 2 || m_currentIndex < 0) {
+        return;
+    }
+
+    const int width = tabWidth();
+    if (!m_isDragging) {
+        m_isDragging = true;
+        m_dragX = m_currentIndex * width;
+    }
+
+    m_dragX = qBound(0, m_dragX + pos.x() - m_dragPos.x(), (m_tabs.size() - 1) * width);
+    m_dragPos = pos;
+
+    // 拖动标签的边缘越过相邻标签中线时交换位置
+    // 被让开的相邻标签从当前位置滑到空出的位置，其余标签不受影响
+    int index = m_currentIndex;
+    while (index > 0 && m_dragX < (index - 1) * width + width / 2) {
+        const int fromX = displayX(index - 1);
+        moveTab(index, index - 1);
+        --index;
+        slideTab(m_tabs.at(index + 1).id, fromX, (index + 1) * width, kSlideDuration);
+    }
+    while (index < m_tabs.size() - 1 && m_dragX > index * width + width / 2) {
+        const int fromX = displayX(index + 1);
+        moveTab(index, index + 1);
+        ++index;
+        slideTab(m_tabs.at(index - 1).id, fromX, (index - 1) * width, kSlideDuration);
+    }
+
+    updateLayout();
+}
+
+void VirtualTabBar::moveTab(int from, int to)
+{
+    m_tabs.move(from, to);
+    for (int i = qMin(from, to); i <= qMax(from, to); ++i) {
+        m_positions.insert(m_tabs.at(i).id, i);
+    }
+
+    if (m_currentIndex == from) {
+        m_currentIndex = to;
+    } else if (from < m_currentIndex && to >= m_currentIndex) {
+        --m_currentIndex;
+    } else if (from > m_currentIndex && to <= m_currentIndex) {
+        ++m_currentIndex;
+    }
+
+    emit tabMoved(from, to);
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <functional>
+
+#include <QHash>
+#include <QIcon>
+#include <QColor>
+#include <QVector>
+#include <QWidget>
+
+#include "QFluent/TabBar.h"
+#include "../Common/AnimationClock.h"
+
+/**
+ * @brief 虚拟化标签栏
+ *
+ * 接口与 TabBar 保持一致。标签以轻量记录保存（路由键、文本、图标、提示），
+ * 所有标签等宽，宽度和位置由最小/最大宽度直接算出，不经过布局；
+ * 只有与可见区域相交的标签才绑定 TabItem，滚出可见区域的 TabItem 回收复用。
+ * 数百个标签时布局和滚动的开销只与可见标签数有关。
+ *
+ * 每个标签有一个稳定编号，路由键 -> 编号 -> 下标都经过哈希表，拖动时相邻交换只更新两项。
+ * 位置变化只对实例化的标签做滑动动画，统一由 AnimationClock 推进。
+ */
+class VirtualTabBar : public QWidget
+{
+    Q_OBJECT
+    Q_PROPERTY(bool movable READ isMovable WRITE setMovable)
+    Q_PROPERTY(bool scrollable READ isScrollable WRITE setScrollable)
+    Q_PROPERTY(int tabMaxWidth READ tabMaximumWidth WRITE setTabMaximumWidth)
+    Q_PROPERTY(int tabMinWidth READ tabMinimumWidth WRITE setTabMinimumWidth)
+    Q_PROPERTY(bool tabShadowEnabled READ isTabShadowEnabled WRITE setTabShadowEnabled)
+
+public:
+    using TabId = quint64;
+
+    explicit VirtualTabBar(QWidget *parent = nullptr);
+
+    void setAddButtonVisible(bool visible);
+    TransparentToolButton *addButton() const { return m_addButton; }
+
+    /**
+     * @return 新标签的下标
+     */
+    int addTab(const QString &routeKey, const QString &text,
+               const QIcon &icon = QIcon(),
+               std::function<void()> onClick = nullptr);
+    int insertTab(int index, const QString &routeKey, const QString &text,
+                  const QIcon &icon = QIcon(),
+                  std::function<void()> onClick = nullptr);
+    void removeTab(int index);
+    void removeTabByKey(const QString &routeKey);
+
+    void setCurrentIndex(int index);
+    void setCurrentTab(const QString &routeKey);
+    int currentIndex() const { return m_currentIndex; }
+    QString currentRouteKey() const;
+
+    int indexOf(const QString &routeKey) const;
+    QString routeKey(int index) const;
+
+    /**
+     * @brief 已实例化的标签控件，标签不在可见区域时返回 nullptr
+     */
+    TabItem *tabItem(int index) const;
+    TabItem *tab(const QString &routeKey) const;
+    TabItem *currentTab() const;
+
+    /**
+     * @brief 标签在整条标签栏内容中的位置（未减去滚动偏移）
+     */
+    QRect tabRect(int index) const;
+    void ensureVisible(int index);
+
+    QString tabText(int index) const;
+    QIcon tabIcon(int index) const;
+    QString tabToolTip(int index) const;
+
+    void setTabText(int index, const QString &text);
+    void setTabIcon(int index, const QIcon &icon);
+    void setTabToolTip(int index, const QString &toolTip);
+    void setTabTextColor(int index, const QColor &color);
+    void setTabSelectedBackgroundColor(const QColor &light, const QColor &dark);
+
+    void setCloseButtonDisplayMode(TabCloseButtonDisplayMode mode);
+    TabCloseButtonDisplayMode closeButtonDisplayMode() const { return m_closeButtonDisplayMode; }
+
+    void setTabsClosable(bool closable);
+    bool tabsClosable() const { return m_closeButtonDisplayMode != TabCloseButtonDisplayMode::Never; }
+
+    void setTabShadowEnabled(bool enabled);
+    bool isTabShadowEnabled() const { return m_isTabShadowEnabled; }
+
+    void setMovable(bool movable) { m_isMovable = movable; }
+    bool isMovable() const { return m_isMovable; }
+
+    void setScrollable(bool scrollable);
+    bool isScrollable() const { return m_isScrollable; }
+
+    void setTabMaximumWidth(int width);
+    int tabMaximumWidth() const { return m_tabMaxWidth; }
+
+    void setTabMinimumWidth(int width);
+    int tabMinimumWidth() const { return m_tabMinWidth; }
+
+    int count() const { return m_tabs.size(); }
+
+    /**
+     * @brief 当前实例化的 TabItem 数量（含回收池），用于调试
+     */
+    int realizedCount() const { return m_realized.size() + m_pool.size(); }
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+signals:
+    void currentChanged(int index);
+    void tabBarClicked(int index);
+    void tabCloseRequested(int index);
+    void tabAddRequested();
+    void tabMoved(int from, int to);
+
+    /**
+     * @brief 新建了 TabItem，例如需要在标题栏中设置命中测试
+     */
+    void itemCreated(TabItem *item);
+
+protected:
+    void resizeEvent(QResizeEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    bool eventFilter(QObject *obj, QEvent *e) override;
+
+private:
+    struct Slide {
+        qreal x = 0;
+        AnimationClock::TweenId tweenId = 0;
+    };
+
+    struct TabRecord {
+        TabId id = 0;
+        QString routeKey;
+        QString text;
+        QIcon icon;
+        QString toolTip;
+        QColor textColor;
+        std::function<void()> onClick;
+    };
+
+    int tabWidth() const;
+    int viewportWidth() const;
+    int contentWidth() const;
+    void setScrollOffset(int offset);
+    void updateLayout();
+
+    TabItem *acquireItem();
+    void recycleItem(TabItem *item);
+    void bindItem(TabItem *item, const TabRecord &record);
+    TabItem *realizedItem(int index) const;
+    int indexOfId(TabId id) const;
+    void reindex(int from);
+
+    int displayX(int index) const;
+    void slideTab(TabId id, int fromX, int toX, int duration);
+
+    void onItemPressed(TabItem *item);
+    void dragTo(const QPoint &pos);
+    void moveTab(int from, int to);
+
+    QWidget *m_view;
+    TransparentToolButton *m_addButton;
+
+    QVector<TabRecord> m_tabs;
+    QHash<TabId, TabItem *> m_realized;
+    QHash<TabItem *, TabId> m_itemIds;
+    QVector<TabItem *> m_pool;
+    QHash<QString, TabId> m_idsByKey;
+    QHash<TabId, int> m_positions;
+    QHash<TabId, Slide> m_slides;
+    TabId m_nextId;
+
+    QColor m_lightSelectedBackgroundColor;
+    QColor m_darkSelectedBackgroundColor;
+
+    int m_currentIndex;
+    int m_scrollOffset;
+    int m_tabMaxWidth;
+    int m_tabMinWidth;
+
+    bool m_isMovable;
+    bool m_isScrollable;
+    bool m_isTabShadowEnabled;
+    bool m_isDragging;
+    QPoint m_dragPos;
+    int m_dragX;
+
+    TabCloseButtonDisplayMode m_closeButtonDisplayMode;
+};
@@ -0,0 +1,698 @@
+#include "CachedTableItemDelegate.h"
+
+#include <QEvent>
+#include <QStyle>
+#include <QTimer>
+#include <QtMath>
+#include <QPalette>
+#include <QPainter>
+#include <QMouseEvent>
+#include <QFontMetrics>
+#include <QApplication>
+#include <QTableView>
+#include <QScrollBar>
+#include <QHeaderView>
+#include <QPainterPath>
+#include <QAbstractItemModel>
+#include <QItemSelectionModel>
+
+#include "Theme.h"
+#include "QFluent/LineEdit.h"
+
+namespace {
+constexpr int kRowMargin = 2;
+constexpr int kFontSize = 13;
+constexpr int kEditorMargin = 8;
+constexpr int kBorderRadius = 5;
+constexpr int kIndicatorWidth = 3;
+constexpr int kCheckBoxSize = 19;
+constexpr int kSpritePadding = 1;
+constexpr int kMaxSpriteCount = 256;
+constexpr int kMaxElisionCount = 4096;
+constexpr int kElisionResetDelay = 300;
+}
+
+CachedTableItemDelegate::CachedTableItemDelegate(QAbstractItemView *parent)
+    : QStyledItemDelegate(parent)
+    , m_view(parent)
+    , m_uniformRowHeight(0)
+    , m_savedResizeMode(QHeaderView::Interactive)
+    , m_savedSectionSize(0)
+    , m_hoverRow(-1)
+    , m_elisionCache(kMaxElisionCount)
+    , m_elisionResetTimer(new QTimer(this))
+    , m_isSelectionDirty(true)
+{
+    m_elisionResetTimer->setSingleShot(true);
+    m_elisionResetTimer->setInterval(kElisionResetDelay);
+    connect(m_elisionResetTimer, &QTimer::timeout, this, &CachedTableItemDelegate::invalidateElisionCache);
+
+    // TableBase 只把悬停和按下的行写进它自己的代理，这里自行跟踪一份用于绘制
+    if (m_view) {
+        connect(m_view, &QAbstractItemView::entered, this, [this](const QModelIndex &index) {
+            setHoverRow(index.row());
+        });
+        m_view->viewport()->installEventFilter(this);
+    }
+
+    // 键中含宽度，列宽变化后旧结果只是不再命中；拖动列宽时每个像素都会触发，
+    // 等拖动停下后再释放旧宽度的结果，拖动中由 QCache 的容量兜底
+    if (auto table = qobject_cast<QTableView *>(m_view)) {
+        connect(table->horizontalHeader(), &QHeaderView::sectionResized,
+                m_elisionResetTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    }
+}
+
+void CachedTableItemDelegate::setUniformRowHeight(int height)
+{
+    height = qMax(0, height);
+    const bool wasUniform = m_uniformRowHeight > 0;
+    m_uniformRowHeight = height;
+
+    // 固定尺寸的表头不会再为 ResizeToContents 逐行询问 sizeHint，
+    // 总高度和滚动范围由 count * sectionSize 直接得到
+    if (auto table = qobject_cast<QTableView *>(m_view)) {
+        QHeaderView *header = table->verticalHeader();
+        if (m_uniformRowHeight > 0) {
+            // 只在进入统一行高时记录原设置；QHeaderView 没有读取全局模式的接口，
+            // 没有行时按默认的 Interactive 处理
+            if (!wasUniform) {
+                m_savedResizeMode = header->count() > 0 ? header->sectionResizeMode(0) : QHeaderView::Interactive;
+                m_savedSectionSize = header->defaultSectionSize();
+            }
+            header->setSectionResizeMode(QHeaderView::Fixed);
+            header->setDefaultSectionSize(m_uniformRowHeight);
+        } else if (wasUniform) {
+            header->setDefaultSectionSize(m_savedSectionSize);
+            header->setSectionResizeMode(m_savedResizeMode);
+        }
+    }
+
+    if (m_view) {
+        m_view->viewport()->update();
+    }
+}
+
+int CachedTableItemDelegate::uniformRowHeight() const
+{
+    return m_uniformRowHeight;
+}
+
+bool CachedTableItemDelegate::isUniformRowHeight() const
+{
+    return m_uniformRowHeight > 0;
+}
+
+void CachedTableItemDelegate::setHoverRow(int row)
+{
+    m_hoverRow = row;
+}
+
+int CachedTableItemDelegate::pressedRow() const
+{
+    // 持久索引随排序和增删行移动，行被删除后自动失效
+    return m_pressedIndex.isValid() ? m_pressedIndex.row() : -1;
+}
+
+void CachedTableItemDelegate::invalidateSizeHints()
+{
+    m_rowSizeCache.clear();
+}
+
+void CachedTableItemDelegate::invalidateElisionCache()
+{
+    m_elisionResetTimer->stop();
+    m_elisionCache.clear();
+}
+
+QSize CachedTableItemDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    if (!index.isValid()) {
+        return baseSizeHint(option, index);
+    }
+
+    bindModel(index.model());
+
+    // 统一行高：只跳过高度的计算，宽度与内容相关，仍逐格询问
+    if (m_uniformRowHeight > 0) {
+        return QSize(baseSizeHint(option, index).width(), m_uniformRowHeight);
+    }
+
+    // 树形模型的子项行号不唯一，不参与缓存
+    if (index.parent().isValid()) {
+        return baseSizeHint(option, index);
+    }
+
+    // 视图字体或图标尺寸变化后，已缓存的尺寸全部作废
+    if (option.font != m_sizeHintFont || option.decorationSize != m_sizeHintDecorationSize) {
+        m_rowSizeCache.clear();
+        m_sizeHintFont = option.font;
+        m_sizeHintDecorationSize = option.decorationSize;
+    }
+
+    if (m_rowSizeCache.size() <= index.row()) {
+        m_rowSizeCache.resize(index.row() + 1);
+    }
+
+    QVector<QSize> &row = m_rowSizeCache[index.row()];
+    if (row.size() <= index.column()) {
+        row.resize(index.column() + 1);
+    }
+
+    QSize &size = row[index.column()];
+    if (!size.isValid()) {
+        size = baseSizeHint(option, index);
+    }
+    return size;
+}
+
+QSize CachedTableItemDelegate::baseSizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    // 绘制时上下各留出 kRowMargin，尺寸里一并算上
+    return QStyledItemDelegate::sizeHint(option, index) + QSize(0, 2 * kRowMargin);
+}
+
+QWidget *CachedTableItemDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem &option,
+                                               const QModelIndex &index) const
+{
+    Q_UNUSED(option)
+    Q_UNUSED(index)
+
+    auto lineEdit = new LineEdit(parent);
+    lineEdit->setProperty("transparent", false);
+    lineEdit->setStyle(QApplication::style());
+    lineEdit->setClearButtonEnabled(true);
+    return lineEdit;
+}
+
+void CachedTableItemDelegate::updateEditorGeometry(QWidget *editor, const QStyleOptionViewItem &option,
+                                                   const QModelIndex &index) const
+{
+    const QRect rect = option.rect;
+    const int y = rect.y() + (rect.height() - editor->height()) / 2;
+    const int x = qMax(kEditorMargin, rect.x());
+    int width = rect.width();
+    if (index.column() == 0) {
+        width -= kEditorMargin;
+    }
+    editor->setGeometry(x, y, width, rect.height());
+}
+
+void CachedTableItemDelegate::initStyleOption(QStyleOptionViewItem *option, const QModelIndex &index) const
+{
+    QStyledItemDelegate::initStyleOption(option, index);
+
+    const QVariant font = index.data(Qt::FontRole);
+    option->font = font.isValid() ? font.value<QFont>() : Theme::instance()->getFont(kFontSize);
+
+    QColor textColor = Theme::instance()->isDarkTheme() ? Qt::white : Qt::black;
+    const QVariant foreground = index.data(Qt::ForegroundRole);
+    if (foreground.isValid()) {
+        textColor = foreground.userType() == QMetaType::QColor ? foreground.value<QColor>()
+                                                               : foreground.value<QBrush>().color();
+    }
+    option->palette.setColor(QPalette::Text, textColor);
+    option->palette.setColor(QPalette::HighlightedText, textColor);
+}
+
+void CachedTableItemDelegate::bindModel(const QAbstractItemModel *model) const
+{
+    if (m_model == model) {
+        return;
+    }
+
+    for (const QMetaObject::Connection &connection : m_modelConnections) {
+        QObject::disconnect(connection);
+    }
+    m_modelConnections.clear();
+    m_rowSizeCache.clear();
+    m_model = model;
+
+    if (!model) {
+        return;
+    }
+
+    auto self = const_cast<CachedTableItemDelegate *>(this);
+    auto clearAll = [self]() { self->invalidateSizeHints(); };
+
+    m_modelConnections << connect(model, &QAbstractItemModel::dataChanged, self,
+                                  [self](const QModelIndex &topLeft, const QModelIndex &bottomRight) {
+        if (topLeft.parent().isValid()) {
+            return;
+        }
+        self->invalidateRows(topLeft.row(), bottomRight.row());
+    });
+
+    // 增删行时把后面的行整体平移，已计算的尺寸继续有效
+    m_modelConnections << connect(model, &QAbstractItemModel::rowsInserted, self,
+                                  [self](const QModelIndex &parent, int first, int last) {
+        if (!parent.isValid()) {
+            self->insertRows(first, last);
+        }
+    });
+    m_modelConnections << connect(model, &QAbstractItemModel::rowsRemoved, self,
+                                  [self](const QModelIndex &parent, int first, int last) {
+        if (!parent.isValid()) {
+            self->removeRows(first, last);
+        }
+    });
+
+    // 移动、列变化和重排后行列对应关系无法局部修正，直接清空
+    m_modelConnections << connect(model, &QAbstractItemModel::rowsMoved, self, clearAll);
+    m_modelConnections << connect(model, &QAbstractItemModel::columnsInserted, self, clearAll);
+    m_modelConnections << connect(model, &QAbstractItemModel::columnsRemoved, self, clearAll);
+    m_modelConnections << connect(model, &QAbstractItemModel::columnsMoved, self, clearAll);
+    m_modelConnections << connect(model, &QAbstractItemModel::layoutChanged, self, clearAll);
+    m_modelConnections << connect(model, &QAbstractItemModel::modelReset, self, clearAll);
+}
+
+void CachedTableItemDelegate::invalidateRows(int first, int last) const
+{
+    // 覆盖全部已缓存行时直接清空
+    if (first <= 0 && last + 1 >= m_rowSizeCache.size()) {
+        m_rowSizeCache.clear();
+        return;
+    }
+
+    last = qMin(last, m_rowSizeCache.size() - 1);
+    for (int row = qMax(0, first); row <= last; ++row) {
+        m_rowSizeCache[row].clear();
+    }
+}
+
+void CachedTableItemDelegate::insertRows(int first, int last) const
+{
+    if (first < m_rowSizeCache.size()) {
+        m_rowSizeCache.insert(first, last - first + 1, QVector<QSize>());
+    }
+}
+
+void CachedTableItemDelegate::removeRows(int first, int last) const
+{
+    if (first < m_rowSizeCache.size()) {
+        m_rowSizeCache.remove(first, qMin(last + 1, m_rowSizeCache.size()) - first);
+    }
+}
+
+void CachedTableItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    QStyleOptionViewItem opt(option);
+    opt.rect.adjust(0, kRowMargin, 0, -kRowMargin);
+
+    painter->save();
+    painter->setClipRect(option.rect);
+
+    const QColor color = rowBackgroundColor(index);
+    if (color.alpha() > 0) {
+        drawRowBackground(painter, opt.rect, index, color);
+    }
+
+    if (index.column() == 0 && isRowSelected(index)
+            && m_view && m_view->horizontalScrollBar()->value() == 0) {
+        drawRowIndicator(painter, opt.rect, index);
+    }
+
+    const QVariant checkState = index.data(Qt::CheckStateRole);
+    if (checkState.isValid()) {
+        drawCheckSprite(painter, opt.rect, static_cast<Qt::CheckState>(checkState.toInt()));
+    }
+
+    painter->restore();
+
+    // 背景、指示条和复选框已经贴好，剩下的只有样式绘制和文字
+    drawItem(painter, opt, index);
+}
+
+void CachedTableItemDelegate::drawItem(QPainter *painter, const QStyleOptionViewItem &option,
+                                       const QModelIndex &index) const
+{
+    QStyleOptionViewItem opt(option);
+    initStyleOption(&opt, index);
+
+    const QWidget *widget = opt.widget;
+    QStyle *style = widget ? widget->style() : QApplication::style();
+
+    // 多行和自动换行的文字仍交给样式排版
+    if (opt.text.isEmpty() || (opt.features & QStyleOptionViewItem::WrapText)
+            || opt.text.contains(QLatin1Char('\n'))) {
+        style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
+        return;
+    }
+
+    const QRect textRect = style->subElementRect(QStyle::SE_ItemViewItemText, &opt, widget);
+    const QString text = opt.text;
+
+    // 图标、焦点框等仍由样式绘制，只把文字拿出来
+    opt.text.clear();
+    style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
+
+    // 与 QCommonStyle 绘制项文字时的左右边距保持一致
+    const int margin = style->pixelMetric(QStyle::PM_FocusFrameHMargin, nullptr, widget) + 1;
+    const QRect rect = textRect.adjusted(margin, 0, -margin, 0);
+    if (rect.width() <= 0) {
+        return;
+    }
+
+    const ElidedText &elided = elidedText(text, opt.font, rect.width(), opt.textElideMode);
+    const QSizeF size = elided.staticText.size();
+
+    const Qt::Alignment alignment = QStyle::visualAlignment(opt.direction, opt.displayAlignment);
+    qreal x = rect.x();
+    if (alignment & Qt::AlignRight) {
+        x = rect.right() + 1 - size.width();
+    } else if (alignment & Qt::AlignHCenter) {
+        x = rect.x() + (rect.width() - size.width()) / 2;
+    }
+
+    qreal y = rect.y() + (rect.height() - size.height()) / 2;
+    if (alignment & Qt::AlignTop) {
+        y = rect.y();
+    } else if (alignment & Qt::AlignBottom) {
+        y = rect.bottom() + 1 - size.height();
+    }
+
+    QPalette::ColorGroup group = QPalette::Normal;
+    if (!(opt.state & QStyle::State_Enabled)) {
+        group = QPalette::Disabled;
+    } else if (!(opt.state & QStyle::State_Active)) {
+        group = QPalette::Inactive;
+    }
+    const QPalette::ColorRole role = (opt.state & QStyle::State_Selected) ? QPalette::HighlightedText : QPalette::Text;
+
+    // 画笔字体与排版时一致，drawStaticText 才会直接复用已排好的字形
+    painter->save();
+    painter->setFont(opt.font);
+    painter->setPen(opt.palette.color(group, role));
+    painter->drawStaticText(QPointF(x, y), elided.staticText);
+    painter->restore();
+}
+
+const CachedTableItemDelegate::ElidedText &CachedTableItemDelegate::elidedText(
+        const QString &text, const QFont &font, int width, Qt::TextElideMode mode) const
+{
+    const ElisionKey key{text, font, width, int(mode)};
+    if (ElidedText *cached = m_elisionCache.object(key)) {
+        return *cached;
+    }
+
+    auto entry = new ElidedText;
+    entry->text = QFontMetrics(font).elidedText(text, mode, width);
+    entry->staticText.setText(entry->text);
+    entry->staticText.setTextFormat(Qt::PlainText);
+    entry->staticText.setPerformanceHint(QStaticText::AggressiveCaching);
+    entry->staticText.prepare(QTransform(), font);
+
+    m_elisionCache.insert(key, entry);
+    return *entry;
+}
+
+bool CachedTableItemDelegate::eventFilter(QObject *obj, QEvent *e)
+{
+    if (!m_view || obj != m_view->viewport()) {
+        return QStyledItemDelegate::eventFilter(obj, e);
+    }
+
+    switch (e->type()) {
+    case QEvent::Leave:
+        setHoverRow(-1);
+        break;
+    case QEvent::FontChange:
+        invalidateElisionCache();
+        invalidateSizeHints();
+        break;
+    case QEvent::MouseButtonPress: {
+        // 与 TableBase 一致：无选择模式下不记录，按在空白处不改变
+        auto mouseEvent = static_cast<QMouseEvent *>(e);
+        const QModelIndex index = m_view->indexAt(mouseEvent->pos());
+        if (index.isValid() && m_view->selectionMode() != QAbstractItemView::NoSelection) {
+            m_pressedIndex = index;
+        }
+        break;
+    }
+    case QEvent::MouseButtonRelease: {
+        // 在空白处释放或右键释放时清除按下状态
+        auto mouseEvent = static_cast<QMouseEvent *>(e);
+        if (!m_view->indexAt(mouseEvent->pos()).isValid() || mouseEvent->button() == Qt::RightButton) {
+            m_pressedIndex = QPersistentModelIndex();
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    // 视口不是编辑器，不交给 QStyledItemDelegate 的编辑器事件处理
+    return false;
+}
+
+bool CachedTableItemDelegate::isRowSelected(const QModelIndex &index) const
+{
+    if (!m_view || !m_view->selectionModel()
+            || m_view->selectionMode() == QAbstractItemView::NoSelection) {
+        return false;
+    }
+    if (index.parent().isValid()) {
+        return m_view->selectionModel()->rowIntersectsSelection(index.row(), index.parent());
+    }
+    return selectedRows().contains(index.row());
+}
+
+const QSet<int> &CachedTableItemDelegate::selectedRows() const
+{
+    QItemSelectionModel *selectionModel = m_view ? m_view->selectionModel() : nullptr;
+    if (selectionModel != m_selectionModel) {
+        bindSelectionModel(selectionModel);
+    }
+
+    // 每格都查询选择模型要遍历全部选区，选区变化后只在下一次绘制时展开一次
+    if (m_isSelectionDirty) {
+        m_selectedRows.clear();
+        if (selectionModel) {
+            const QItemSelection selection = selectionModel->selection();
+            for (const QItemSelectionRange &range : selection) {
+                if (range.parent().isValid()) {
+                    continue;
+                }
+                for (int row = range.top(); row <= range.bottom(); ++row) {
+                    m_selectedRows.insert(row);
+                }
+            }
+        }
+        m_isSelectionDirty = false;
+    }
+    return m_selectedRows;
+}
+
+void CachedTableItemDelegate::bindSelectionModel(QItemSelectionModel *selectionModel) const
+{
+    for (const QMetaObject::Connection &connection : m_selectionConnections) {
+        QObject::disconnect(connection);
+    }
+    m_selectionConnections.clear();
+    m_selectionModel = selectionModel;
+    m_isSelectionDirty = true;
+
+    if (!selectionModel) {
+        return;
+    }
+
+    auto self = const_cast<CachedTableItemDelegate *>(this);
+    auto markDirty = [self]() { self->m_isSelectionDirty = true; };
+    m_selectionConnections << connect(selectionModel, &QItemSelectionModel::selectionChanged, self, markDirty);
+
+    // 布局变化和增删行后选区随持久索引移动，不一定发出 selectionChanged
+    if (const QAbstractItemModel *model = selectionModel->model()) {
+        m_selectionConnections << connect(model, &QAbstractItemModel::layoutChanged, self, markDirty);
+        m_selectionConnections << connect(model, &QAbstractItemModel::rowsInserted, self, markDirty);
+        m_selectionConnections << connect(model, &QAbstractItemModel::rowsRemoved, self, markDirty);
+        m_selectionConnections << connect(model, &QAbstractItemModel::rowsMoved, self, markDirty);
+        m_selectionConnections << connect(model, &QAbstractItemModel::modelReset, self, markDirty);
+    }
+}
+
+QColor CachedTableItemDelegate::rowBackgroundColor(const QModelIndex &index) const
+{
+    const QVariant background = index.data(Qt::BackgroundRole);
+    if (background.isValid()) {
+        if (background.userType() == QMetaType::QColor) {
+            return background.value<QColor>();
+        }
+        return background.value<QBrush>().color();
+    }
+
+    const int row = index.row();
+    const bool isDark = Theme::instance()->isDarkTheme();
+    const bool isHover = row == m_hoverRow;
+    const bool isPressed = row == pressedRow();
+    const bool isAlternate = row % 2 == 0 && m_view && m_view->alternatingRowColors();
+
+    int alpha = 0;
+    if (!isRowSelected(index)) {
+        if (isPressed) {
+            alpha = isDark ? 9 : 6;
+        } else if (isHover) {
+            alpha = 12;
+        } else if (isAlternate) {
+            alpha = 5;
+        }
+    } else {
+        if (isPressed) {
+            alpha = isDark ? 15 : 9;
+        } else {
+            alpha = isDark ? 17 : 12;
+        }
+    }
+
+    const int c = isDark ? 255 : 0;
+    return QColor(c, c, c, alpha);
+}
+
+void CachedTableItemDelegate::drawRowBackground(QPainter *painter, const QRect &rect,
+                                                const QModelIndex &index, const QColor &color) const
+{
+    // 行背景是横向的三段式：首列左端和末列右端贴圆角精灵图，其余部分直接填充；
+    // 只有一列时同一格两端都要贴
+    const qreal dpr = painter->device()->devicePixelRatioF();
+    const int lastColumn = index.model()->columnCount(index.parent()) - 1;
+
+    int left = rect.x();
+    int right = rect.right() + 1;
+    if (index.column() == 0) {
+        left += 4;
+        painter->drawPixmap(left, rect.y(), sprite(SpriteKind::LeftCap, color, rect.height(), dpr));
+        left += kBorderRadius;
+    }
+    if (index.column() == lastColumn) {
+        right -= 4 + kBorderRadius;
+        painter->drawPixmap(right, rect.y(), sprite(SpriteKind::RightCap, color, rect.height(), dpr));
+    }
+    painter->fillRect(QRect(left, rect.y(), qMax(0, right - left), rect.height()), color);
+}
+
+void CachedTableItemDelegate::drawRowIndicator(QPainter *painter, const QRect &rect, const QModelIndex &index) const
+{
+    const qreal dpr = painter->device()->devicePixelRatioF();
+    const SpriteKind kind = pressedRow() == index.row() ? SpriteKind::PressedIndicator : SpriteKind::Indicator;
+    painter->drawPixmap(rect.x() + 4, rect.y(),
+                        sprite(kind, Theme::instance()->themeColor(), rect.height(), dpr));
+}
+
+void CachedTableItemDelegate::drawCheckSprite(QPainter *painter, const QRect &rect, Qt::CheckState state) const
+{
+    const qreal dpr = painter->device()->devicePixelRatioF();
+
+    SpriteKind kind = SpriteKind::Unchecked;
+    QColor color = Theme::instance()->isDarkTheme() ? Qt::white : Qt::black;
+    if (state != Qt::Unchecked) {
+        kind = state == Qt::Checked ? SpriteKind::Checked : SpriteKind::PartiallyChecked;
+        color = Theme::instance()->themeColor();
+    }
+
+    const int x = rect.x() + 15 - kSpritePadding;
+    const int y = rect.center().y() - 10 - kSpritePadding;
+    painter->drawPixmap(x, y, sprite(kind, color, kCheckBoxSize, dpr));
+}
+
+const QPixmap &CachedTableItemDelegate::sprite(SpriteKind kind, const QColor &color, int height, qreal dpr) const
+{
+    const quint64 isDark = Theme::instance()->isDarkTheme() ? 1 : 0;
+    const quint64 key = (quint64(color.rgba()) << 32)
+                        | (quint64(qRound(dpr * 100) & 0xFFF) << 16)
+                        | (quint64(qBound(0, height, 0xFFF)) << 4)
+                        | (isDark << 3)
+                        | quint64(kind);
+
+    auto it = m_sprites.constFind(key);
+    if (it != m_sprites.constEnd()) {
+        return it.value();
+    }
+
+    if (m_sprites.size() >= kMaxSpriteCount) {
+        m_sprites.clear();
+    }
+    return *m_sprites.insert(key, renderSprite(kind, color, height, dpr));
+}
+
+QPixmap CachedTableItemDelegate::renderSprite(SpriteKind kind, const QColor &color, int height, qreal dpr) const
+{
+    const int r = kBorderRadius;
+    const int checkBoxSize = kCheckBoxSize + 2 * kSpritePadding;
+
+    QSize size;
+    switch (kind) {
+    case SpriteKind::LeftCap:
+    case SpriteKind::RightCap:
+        size = QSize(r, height);
+        break;
+    case SpriteKind::Indicator:
+    case SpriteKind::PressedIndicator:
+        size = QSize(kIndicatorWidth, height);
+        break;
+    default:
+        size = QSize(checkBoxSize, checkBoxSize + 1);
+        break;
+    }
+
+    QPixmap pixmap(qCeil(size.width() * dpr), qCeil(size.height() * dpr));
+    pixmap.setDevicePixelRatio(dpr);
+    pixmap.fill(Qt::transparent);
+
+    QPainter painter(&pixmap);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(Qt::NoPen);
+
+    const bool isDark = Theme::instance()->isDarkTheme();
+
+    switch (kind) {
+    case SpriteKind::LeftCap:
+        painter.setBrush(color);
+        painter.drawRoundedRect(QRectF(0, 0, 2 * r + 1, height), r, r);
+        break;
+    case SpriteKind::RightCap:
+        painter.setBrush(color);
+        painter.drawRoundedRect(QRectF(-r - 1, 0, 2 * r + 1, height), r, r);
+        break;
+    case SpriteKind::Indicator:
+    case SpriteKind::PressedIndicator: {
+        const int ph = qRound(kind == SpriteKind::PressedIndicator ? 0.35 * height : 0.257 * height);
+        painter.setBrush(color);
+        painter.drawRoundedRect(QRectF(0, ph, kIndicatorWidth, height - 2 * ph), 1.5, 1.5);
+        break;
+    }
+    default: {
+        const QRectF rect(kSpritePadding, kSpritePadding + 0.5, kCheckBoxSize, kCheckBoxSize);
+        if (kind == SpriteKind::Unchecked) {
+            painter.setBrush(isDark ? QColor(0, 0, 0, 26) : QColor(0, 0, 0, 6));
+            painter.setPen(isDark ? QColor(255, 255, 255, 142) : QColor(0, 0, 0, 122));
+        } else {
+            painter.setBrush(color);
+            painter.setPen(color);
+        }
+        painter.drawRoundedRect(rect, 4.5, 4.5);
+
+        if (kind == SpriteKind::Unchecked) {
+            break;
+        }
+
+        QPen pen(isDark ? Qt::black : Qt::white, 1.5);
+        pen.setCapStyle(Qt::RoundCap);
+        pen.setJoinStyle(Qt::RoundJoin);
+        painter.setPen(pen);
+        painter.setBrush(Qt::NoBrush);
+
+        const QPointF origin = rect.topLeft();
+        if (kind == SpriteKind::Checked) {
+            QPainterPath path;
+            path.moveTo(origin + QPointF(5, 10));
+            path.lineTo(origin + QPointF(8.5, 13.5));
+            path.lineTo(origin + QPointF(14.5, 6.5));
+            painter.drawPath(path);
+        } else {
+            painter.drawLine(origin + QPointF(5.5, 9.5), origin + QPointF(13.5, 9.5));
+        }
+        break;
+    }
+    }
+
+    return pixmap;
+}
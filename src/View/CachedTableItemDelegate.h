@@ -0,0 +1,168 @@
+#pragma once
+
+#include <QFont>
+#include <QSet>
+#include <QHash>
+#include <QCache>
+#include <QVector>
+#include <QPixmap>
+#include <QPointer>
+#include <QStaticText>
+#include <QHeaderView>
+#include <QStyledItemDelegate>
+#include <QPersistentModelIndex>
+
+class QTimer;
+class QAbstractItemView;
+class QAbstractItemModel;
+class QItemSelectionModel;
+
+/**
+ * @brief 带尺寸缓存的表格项代理
+ *
+ * 统一行高模式下行高直接返回声明值，宽度仍按单元格计算，并把视图的垂直表头
+ * 切换为固定尺寸，表头与滚动条的计算不再逐行查询 sizeHint；关闭后恢复表头原来的
+ * 尺寸模式。可变行高时按行缓存各列的 sizeHint，字体或图标尺寸变化时整体失效，
+ * 模型数据变化时只失效受影响的行，增删行时缓存随行号平移。
+ *
+ * 库中的 TableItemDelegate 没有导出，这里直接继承 QStyledItemDelegate，
+ * 悬停、按下和选中行都由本类从视图和选择模型自行跟踪。TableBase::setItemDelegate
+ * 只接受 TableItemDelegate，需通过 QAbstractItemView::setItemDelegate 安装：
+ * @code
+ * view->QAbstractItemView::setItemDelegate(new CachedTableItemDelegate(view));
+ * @endcode
+ * 只用于 TableView / TableWidget。
+ *
+ * 绘制时行背景的圆角端、选中指示条和复选框都取自按颜色、高度和设备像素比
+ * 预先栅格化的精灵图，单元格绘制只剩贴图、填充和文字。
+ *
+ * 单行文字按 (文本, 字体, 可用宽度) 缓存省略后的结果和排好版的 QStaticText，
+ * 字体变化时整体失效，列宽调整停下后释放旧宽度的结果，滚动时不再逐格重新省略和排版。
+ */
+class CachedTableItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit CachedTableItemDelegate(QAbstractItemView *parent = nullptr);
+
+    /**
+     * @brief 声明统一行高
+     * @param height 行高，小于等于 0 表示关闭统一行高模式
+     */
+    void setUniformRowHeight(int height);
+    int uniformRowHeight() const;
+    bool isUniformRowHeight() const;
+
+    /**
+     * @brief 清空尺寸缓存（模型之外影响 sizeHint 的设置变化后调用，字体和图标尺寸的变化会自动处理）
+     */
+    void invalidateSizeHints();
+
+    /**
+     * @brief 清空文字省略缓存（一般无需手动调用，列宽调整结束和字体变化时会自动清空）
+     */
+    void invalidateElisionCache();
+
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    void updateEditorGeometry(QWidget *editor, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    void initStyleOption(QStyleOptionViewItem *option, const QModelIndex &index) const override;
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+protected:
+    bool eventFilter(QObject *obj, QEvent *e) override;
+
+private:
+    enum class SpriteKind {
+        LeftCap,
+        RightCap,
+        Indicator,
+        PressedIndicator,
+        Unchecked,
+        Checked,
+        PartiallyChecked
+    };
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    using HashValue = size_t;
+#else
+    using HashValue = uint;
+#endif
+
+    struct ElisionKey {
+        QString text;
+        QFont font;
+        int width;
+        int mode;
+
+        bool operator==(const ElisionKey &other) const
+        {
+            return width == other.width && mode == other.mode
+                   && text == other.text && font == other.font;
+        }
+
+        friend HashValue qHash(const ElisionKey &key, HashValue seed = 0)
+        {
+            return qHash(key.text, seed) ^ qHash(key.font, seed)
+                   ^ HashValue(key.width * 31 + key.mode);
+        }
+    };
+
+    struct ElidedText {
+        QString text;
+        QStaticText staticText;
+    };
+
+    void bindModel(const QAbstractItemModel *model) const;
+    void invalidateRows(int first, int last) const;
+    void insertRows(int first, int last) const;
+    void removeRows(int first, int last) const;
+    QSize baseSizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const;
+
+    void setHoverRow(int row);
+    int pressedRow() const;
+
+    bool isRowSelected(const QModelIndex &index) const;
+    const QSet<int> &selectedRows() const;
+    void bindSelectionModel(QItemSelectionModel *selectionModel) const;
+    QColor rowBackgroundColor(const QModelIndex &index) const;
+    void drawRowBackground(QPainter *painter, const QRect &rect, const QModelIndex &index, const QColor &color) const;
+    void drawRowIndicator(QPainter *painter, const QRect &rect, const QModelIndex &index) const;
+    void drawCheckSprite(QPainter *painter, const QRect &rect, Qt::CheckState state) const;
+    void drawItem(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const;
+
+    const ElidedText &elidedText(const QString &text, const QFont &font, int width, Qt::TextElideMode mode) const;
+
+    const QPixmap &sprite(SpriteKind kind, const QColor &color, int height, qreal dpr) const;
+    QPixmap renderSprite(SpriteKind kind, const QColor &color, int height, qreal dpr) const;
+
+    QAbstractItemView *m_view;
+    int m_uniformRowHeight;
+    QHeaderView::ResizeMode m_savedResizeMode;
+    int m_savedSectionSize;
+    int m_hoverRow;
+    QPersistentModelIndex m_pressedIndex;
+
+    // (类型, 颜色, 高度, 设备像素比) -> 预渲染精灵图
+    mutable QHash<quint64, QPixmap> m_sprites;
+
+    // (文本, 字体, 宽度, 省略方式) -> 省略结果及其排版
+    mutable QCache<ElisionKey, ElidedText> m_elisionCache;
+    QTimer *m_elisionResetTimer;
+
+    // 行号 -> 各列 sizeHint，无效尺寸表示尚未计算；增删行时整体平移
+    mutable QVector<QVector<QSize>> m_rowSizeCache;
+
+    // 缓存结果所对应的字体和图标尺寸
+    mutable QFont m_sizeHintFont;
+    mutable QSize m_sizeHintDecorationSize;
+    mutable QPointer<const QAbstractItemModel> m_model;
+    mutable QList<QMetaObject::Connection> m_modelConnections;
+
+    // 选中的顶层行号，选区或模型变化后置脏，下一次绘制时重新展开
+    mutable QSet<int> m_selectedRows;
+    mutable bool m_isSelectionDirty;
+    mutable QPointer<QItemSelectionModel> m_selectionModel;
+    mutable QList<QMetaObject::Connection> m_selectionConnections;
+};
@@ -0,0 +1,868 @@
+#include "ConcurrentSortFilterProxyModel.h"
+
+#include <numeric>
+#include <algorithm>
+
+#include <QDate>
+#include <QPair>
+#include <QMutex>
+#include <QTimer>
+#include <QDateTime>
+#include <QAtomicInt>
+#include <QThreadPool>
+
+namespace {
+// 工作线程每处理这么多行检查一次请求是否已作废
+constexpr int kCancelCheckInterval = 4096;
+// 超过这个行数的 dataChanged 直接按整段转发
+constexpr int kMaxMappedDataChangedRows = 1024;
+// 删除的行在代理中分散成超过这么多段时，改为一次布局变化
+constexpr int kMaxRemovedRanges = 32;
+// 源模型布局变化时，代理行数不超过这个值才逐行跟踪源索引
+constexpr int kMaxTrackedLayoutRows = 65536;
+
+/**
+ * @brief 修改快照：没有工作线程持有时原地修改，否则复制一份
+ */
+template <typename T, typename Patch>
+void patchSnapshot(std::shared_ptr<const QVector<T>> &snapshot, Patch patch)
+{
+    if (!snapshot) {
+        return;
+    }
+
+    std::shared_ptr<QVector<T>> keys = snapshot.use_count() == 1
+            ? std::const_pointer_cast<QVector<T>>(snapshot)
+            : std::make_shared<QVector<T>>(*snapshot);
+    patch(*keys);
+    snapshot = keys;
+}
+
+/**
+ * @brief 列移动后原来第 section 列的新位置
+ */
+int movedSection(int section, int start, int end, int destination)
+{
+    const int count = end - start + 1;
+    if (destination > end) {
+        if (section >= start && section <= end) {
+            return section + destination - end - 1;
+        }
+        if (section > end && section < destination) {
+            return section - count;
+        }
+    } else if (destination < start) {
+        if (section >= start && section <= end) {
+            return section - (start - destination);
+        }
+        if (section >= destination && section < start) {
+            return section + count;
+        }
+    }
+    return section;
+}
+}
+
+struct ConcurrentSortFilterProxyModel::Shared {
+    QAtomicInt generation;
+    QMutex mutex;
+    ConcurrentSortFilterProxyModel *proxy = nullptr;
+};
+
+ConcurrentSortFilterProxyModel::ConcurrentSortFilterProxyModel(QObject *parent)
+    : QAbstractProxyModel(parent)
+    , m_shared(std::make_shared<Shared>())
+    , m_scheduleTimer(new QTimer(this))
+    , m_isSourceOrder(true)
+    , m_isLayoutTracked(false)
+    , m_sortColumn(-1)
+    , m_sortOrder(Qt::AscendingOrder)
+    , m_sortRole(Qt::DisplayRole)
+    , m_sortCaseSensitivity(Qt::CaseSensitive)
+    , m_filterKeyColumn(0)
+    , m_filterRole(Qt::DisplayRole)
+    , m_filterCaseSensitivity(Qt::CaseInsensitive)
+    , m_isBusy(false)
+{
+    m_shared->proxy = this;
+
+    // 同一轮事件循环内的多次设置只触发一次后台计算
+    m_scheduleTimer->setSingleShot(true);
+    m_scheduleTimer->setInterval(0);
+    connect(m_scheduleTimer, &QTimer::timeout, this, &ConcurrentSortFilterProxyModel::startJob);
+}
+
+ConcurrentSortFilterProxyModel::~ConcurrentSortFilterProxyModel()
+{
+    // 工作线程投递结果前会持有同一把锁，析构后不会再收到结果
+    QMutexLocker locker(&m_shared->mutex);
+    m_shared->proxy = nullptr;
+    m_shared->generation.ref();
+}
+
+void ConcurrentSortFilterProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+    beginResetModel();
+
+    for (const QMetaObject::Connection &connection : m_sourceConnections) {
+        disconnect(connection);
+    }
+    m_sourceConnections.clear();
+
+    QAbstractProxyModel::setSourceModel(sourceModel);
+    resetMapping();
+
+    if (sourceModel) {
+        using Self = ConcurrentSortFilterProxyModel;
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::dataChanged,
+                                       this, &Self::onSourceDataChanged);
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::headerDataChanged,
+                                       this, &Self::onSourceHeaderDataChanged);
+
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::rowsAboutToBeInserted,
+                                       this, &Self::onSourceRowsAboutToBeInserted);
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::rowsInserted,
+                                       this, &Self::onSourceRowsInserted);
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::rowsAboutToBeRemoved,
+                                       this, &Self::onSourceRowsAboutToBeRemoved);
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::rowsRemoved,
+                                       this, &Self::onSourceRowsRemoved);
+
+        // 行移动与布局变化一样，只是源行换了位置
+        auto layoutAboutToBeChanged = [this]() { onSourceLayoutAboutToBeChanged(); };
+        auto layoutChanged = [this]() { onSourceLayoutChanged(); };
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::rowsAboutToBeMoved, this, layoutAboutToBeChanged);
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::rowsMoved, this, layoutChanged);
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::layoutAboutToBeChanged, this, layoutAboutToBeChanged);
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::layoutChanged, this, layoutChanged);
+
+        // 列与源模型一一对应，直接转发
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::columnsAboutToBeInserted, this,
+                                       [this](const QModelIndex &parent, int first, int last) {
+            if (!parent.isValid()) {
+                beginInsertColumns(QModelIndex(), first, last);
+            }
+        });
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::columnsInserted,
+                                       this, &Self::onSourceColumnsInserted);
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::columnsAboutToBeRemoved, this,
+                                       [this](const QModelIndex &parent, int first, int last) {
+            if (!parent.isValid()) {
+                beginRemoveColumns(QModelIndex(), first, last);
+            }
+        });
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::columnsRemoved,
+                                       this, &Self::onSourceColumnsRemoved);
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::columnsAboutToBeMoved, this,
+                                       [this](const QModelIndex &parent, int start, int end,
+                                              const QModelIndex &destination, int column) {
+            if (!parent.isValid() && !destination.isValid()) {
+                beginMoveColumns(QModelIndex(), start, end, QModelIndex(), column);
+            }
+        });
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::columnsMoved,
+                                       this, &Self::onSourceColumnsMoved);
+
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::modelAboutToBeReset,
+                                       this, [this]() { beginResetModel(); });
+        m_sourceConnections << connect(sourceModel, &QAbstractItemModel::modelReset,
+                                       this, &Self::onSourceModelReset);
+    }
+
+    endResetModel();
+    invalidate();
+}
+
+ConcurrentSortFilterProxyModel::SortKey ConcurrentSortFilterProxyModel::makeSortKey(const QVariant &value)
+{
+    SortKey key;
+    switch (value.userType()) {
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Float:
+    case QMetaType::Double:
+        key.isNumber = true;
+        key.number = value.toDouble();
+        break;
+    case QMetaType::QDate:
+        key.isNumber = true;
+        key.number = value.toDate().toJulianDay();
+        break;
+    case QMetaType::QDateTime:
+        key.isNumber = true;
+        key.number = value.toDateTime().toMSecsSinceEpoch();
+        break;
+    default:
+        key.text = value.toString();
+        break;
+    }
+    return key;
+}
+
+void ConcurrentSortFilterProxyModel::setSortRole(int role)
+{
+    if (m_sortRole == role) {
+        return;
+    }
+    m_sortRole = role;
+    m_sortSnapshot.reset();
+    if (m_sortColumn >= 0) {
+        invalidate();
+    }
+}
+
+void ConcurrentSortFilterProxyModel::setSortCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (m_sortCaseSensitivity == cs) {
+        return;
+    }
+    m_sortCaseSensitivity = cs;
+    if (m_sortColumn >= 0) {
+        invalidate();
+    }
+}
+
+void ConcurrentSortFilterProxyModel::setFilterRole(int role)
+{
+    if (m_filterRole == role) {
+        return;
+    }
+    m_filterRole = role;
+    m_filterSnapshot.reset();
+    if (!m_filterString.isEmpty()) {
+        invalidate();
+    }
+}
+
+void ConcurrentSortFilterProxyModel::setFilterKeyColumn(int column)
+{
+    if (m_filterKeyColumn == column) {
+        return;
+    }
+    m_filterKeyColumn = column;
+    m_filterSnapshot.reset();
+    if (!m_filterString.isEmpty()) {
+        invalidate();
+    }
+}
+
+void ConcurrentSortFilterProxyModel::setFilterCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (m_filterCaseSensitivity == cs) {
+        return;
+    }
+    m_filterCaseSensitivity = cs;
+    if (!m_filterString.isEmpty()) {
+        invalidate();
+    }
+}
+
+void ConcurrentSortFilterProxyModel::setFilterFixedString(const QString &pattern)
+{
+    if (m_filterString == pattern) {
+        return;
+    }
+    m_filterString = pattern;
+    invalidate();
+}
+
+void ConcurrentSortFilterProxyModel::sort(int column, Qt::SortOrder order)
+{
+    if (m_sortColumn == column && m_sortOrder == order) {
+        return;
+    }
+    if (m_sortColumn != column) {
+        m_sortSnapshot.reset();
+    }
+    m_sortColumn = column;
+    m_sortOrder = order;
+    invalidate();
+}
+
+QModelIndex ConcurrentSortFilterProxyModel::mapToSource(const QModelIndex &proxyIndex) const
+{
+    if (!sourceModel() || !proxyIndex.isValid() || proxyIndex.row() >= m_proxyToSource.size()) {
+        return QModelIndex();
+    }
+    return sourceModel()->index(m_proxyToSource.at(proxyIndex.row()), proxyIndex.column());
+}
+
+QModelIndex ConcurrentSortFilterProxyModel::mapFromSource(const QModelIndex &sourceIndex) const
+{
+    if (!sourceIndex.isValid() || sourceIndex.parent().isValid()) {
+        return QModelIndex();
+    }
+
+    const int row = m_sourceToProxy.value(sourceIndex.row(), -1);
+    if (row < 0) {
+        return QModelIndex();
+    }
+    return createIndex(row, sourceIndex.column());
+}
+
+QModelIndex ConcurrentSortFilterProxyModel::index(int row, int column, const QModelIndex &parent) const
+{
+    if (parent.isValid() || row < 0 || column < 0
+            || row >= rowCount() || column >= columnCount()) {
+        return QModelIndex();
+    }
+    return createIndex(row, column);
+}
+
+QModelIndex ConcurrentSortFilterProxyModel::parent(const QModelIndex &child) const
+{
+    Q_UNUSED(child);
+    return QModelIndex();
+}
+
+int ConcurrentSortFilterProxyModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_proxyToSource.size();
+}
+
+int ConcurrentSortFilterProxyModel::columnCount(const QModelIndex &parent) const
+{
+    if (parent.isValid() || !sourceModel()) {
+        return 0;
+    }
+    return sourceModel()->columnCount();
+}
+
+bool ConcurrentSortFilterProxyModel::hasChildren(const QModelIndex &parent) const
+{
+    return !parent.isValid() && !m_proxyToSource.isEmpty();
+}
+
+void ConcurrentSortFilterProxyModel::invalidate()
+{
+    // 先让正在计算的旧请求作废，再合并到下一轮事件循环统一发起
+    m_shared->generation.ref();
+    m_scheduleTimer->start();
+}
+
+void ConcurrentSortFilterProxyModel::invalidateSnapshots()
+{
+    m_sortSnapshot.reset();
+    m_filterSnapshot.reset();
+}
+
+void ConcurrentSortFilterProxyModel::startJob()
+{
+    QAbstractItemModel *model = sourceModel();
+    if (!model) {
+        return;
+    }
+
+    const int generation = m_shared->generation.loadAcquire();
+    const int rowCount = model->rowCount();
+    const bool hasSort = m_sortColumn >= 0 && m_sortColumn < model->columnCount();
+    const bool hasFilter = !m_filterString.isEmpty()
+                           && m_filterKeyColumn >= 0 && m_filterKeyColumn < model->columnCount();
+
+    if (!hasSort && !hasFilter) {
+        if (m_isSourceOrder) {
+            setBusy(false);
+            return;
+        }
+        QVector<int> rows(rowCount);
+        std::iota(rows.begin(), rows.end(), 0);
+        applyResult(generation, rows, true);
+        return;
+    }
+
+    // 模型不保证线程安全，只能在 GUI 线程取快照；过滤词变化时快照可以复用
+    if (hasSort && !m_sortSnapshot) {
+        auto keys = std::make_shared<QVector<SortKey>>(rowCount);
+        for (int row = 0; row < rowCount; ++row) {
+            (*keys)[row] = makeSortKey(model->index(row, m_sortColumn).data(m_sortRole));
+        }
+        m_sortSnapshot = keys;
+    }
+
+    if (hasFilter && !m_filterSnapshot) {
+        auto keys = std::make_shared<QVector<QString>>(rowCount);
+        for (int row = 0; row < rowCount; ++row) {
+            (*keys)[row] = model->index(row, m_filterKeyColumn).data(m_filterRole).toString();
+        }
+        m_filterSnapshot = keys;
+    }
+
+    setBusy(true);
+
+    const std::shared_ptr<Shared> shared = m_shared;
+    const std::shared_ptr<const QVector<SortKey>> sortKeys = hasSort ? m_sortSnapshot : nullptr;
+    const std::shared_ptr<const QVector<QString>> filterKeys = hasFilter ? m_filterSnapshot : nullptr;
+    const QString pattern = m_filterString;
+    const Qt::CaseSensitivity filterCs = m_filterCaseSensitivity;
+    const Qt::CaseSensitivity sortCs = m_sortCaseSensitivity;
+    const Qt::SortOrder order = m_sortOrder;
+
+    QThreadPool::globalInstance()->start([=]() {
+        auto isCancelled = [&]() { return shared->generation.loadAcquire() != generation; };
+
+        QVector<int> rows;
+        rows.reserve(rowCount);
+        for (int row = 0; row < rowCount; ++row) {
+            if (row % kCancelCheckInterval == 0 && isCancelled()) {
+                return;
+            }
+            if (!filterKeys || filterKeys->at(row).contains(pattern, filterCs)) {
+                rows.append(row);
+            }
+        }
+
+        if (sortKeys) {
+            auto lessThan = [&](int lhs, int rhs) {
+                const SortKey &a = sortKeys->at(lhs);
+                const SortKey &b = sortKeys->at(rhs);
+                int result = 0;
+                if (a.isNumber != b.isNumber) {
+                    result = a.isNumber ? -1 : 1;
+                } else if (a.isNumber) {
+                    result = a.number < b.number ? -1 : (a.number > b.number ? 1 : 0);
+                } else {
+                    result = a.text.compare(b.text, sortCs);
+                }
+                return order == Qt::AscendingOrder ? result < 0 : result > 0;
+            };
+
+            // 比较函数必须保持严格弱序，不能在排序中途改变结果；先分块排序再逐层归并，
+            // 在块与块之间检查请求是否已作废。两步都是稳定的，整体结果与 stable_sort 相同
+            const int count = rows.size();
+            for (int begin = 0; begin < count; begin += kCancelCheckInterval) {
+                if (isCancelled()) {
+                    return;
+                }
+                std::stable_sort(rows.begin() + begin, rows.begin() + qMin(begin + kCancelCheckInterval, count),
+                                 lessThan);
+            }
+            for (int width = kCancelCheckInterval; width < count; width *= 2) {
+                for (int begin = 0; begin + width < count; begin += 2 * width) {
+                    if (isCancelled()) {
+                        return;
+                    }
+                    std::inplace_merge(rows.begin() + begin, rows.begin() + begin + width,
+                                       rows.begin() + qMin(begin + 2 * width, count), lessThan);
+                }
+            }
+        }
+
+        QMutexLocker locker(&shared->mutex);
+        ConcurrentSortFilterProxyModel *proxy = shared->proxy;
+        if (!proxy || isCancelled()) {
+            return;
+        }
+        QMetaObject::invokeMethod(proxy, [proxy, generation, rows]() {
+            proxy->applyResult(generation, rows, false);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void ConcurrentSortFilterProxyModel::applyResult(int generation, const QVector<int> &rows, bool isSourceOrder)
+{
+    if (generation != m_shared->generation.loadAcquire()) {
+        return;
+    }
+    setBusy(false);
+
+    emit layoutAboutToBeChanged();
+
+    // 通过源索引迁移持久索引，选中项和当前项随数据一起移动
+    const QModelIndexList oldIndexes = persistentIndexList();
+    QModelIndexList sourceIndexes;
+    sourceIndexes.reserve(oldIndexes.size());
+    for (const QModelIndex &index : oldIndexes) {
+        sourceIndexes << mapToSource(index);
+    }
+
+    m_proxyToSource = rows;
+    m_isSourceOrder = isSourceOrder;
+    rebuildSourceToProxy();
+
+    QModelIndexList newIndexes;
+    newIndexes.reserve(sourceIndexes.size());
+    for (const QModelIndex &index : sourceIndexes) {
+        newIndexes << mapFromSource(index);
+    }
+    changePersistentIndexList(oldIndexes, newIndexes);
+
+    emit layoutChanged();
+}
+
+void ConcurrentSortFilterProxyModel::resetMapping()
+{
+    const int rowCount = sourceModel() ? sourceModel()->rowCount() : 0;
+    m_proxyToSource.resize(rowCount);
+    std::iota(m_proxyToSource.begin(), m_proxyToSource.end(), 0);
+    m_sourceToProxy = m_proxyToSource;
+    m_isSourceOrder = true;
+    invalidateSnapshots();
+}
+
+void ConcurrentSortFilterProxyModel::rebuildSourceToProxy()
+{
+    m_sourceToProxy.fill(-1, sourceModel() ? sourceModel()->rowCount() : 0);
+    for (int row = 0; row < m_proxyToSource.size(); ++row) {
+        m_sourceToProxy[m_proxyToSource.at(row)] = row;
+    }
+}
+
+void ConcurrentSortFilterProxyModel::setBusy(bool busy)
+{
+    if (m_isBusy == busy) {
+        return;
+    }
+    m_isBusy = busy;
+    emit busyChanged(busy);
+}
+
+void ConcurrentSortFilterProxyModel::onSourceDataChanged(const QModelIndex &topLeft,
+                                                         const QModelIndex &bottomRight,
+                                                         const QVector<int> &roles)
+{
+    if (topLeft.parent().isValid()) {
+        return;
+    }
+
+    // 排序列或过滤列的数据变了，快照失效并重新计算
+    auto touches = [&](int column, int role) {
+        return column >= topLeft.column() && column <= bottomRight.column()
+               && (roles.isEmpty() || roles.contains(role));
+    };
+    const bool sortTouched = m_sortColumn >= 0 && touches(m_sortColumn, m_sortRole);
+    const bool filterTouched = !m_filterString.isEmpty() && touches(m_filterKeyColumn, m_filterRole);
+    if (sortTouched) {
+        m_sortSnapshot.reset();
+    }
+    if (filterTouched) {
+        m_filterSnapshot.reset();
+    }
+    if (sortTouched || filterTouched) {
+        invalidate();
+    }
+
+    if (bottomRight.row() - topLeft.row() + 1 > kMaxMappedDataChangedRows) {
+        if (rowCount() > 0) {
+            emit dataChanged(index(0, topLeft.column()), index(rowCount() - 1, bottomRight.column()), roles);
+        }
+        return;
+    }
+
+    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+        const int proxyRow = m_sourceToProxy.value(row, -1);
+        if (proxyRow >= 0) {
+            emit dataChanged(index(proxyRow, topLeft.column()), index(proxyRow, bottomRight.column()), roles);
+        }
+    }
+}
+
+void ConcurrentSortFilterProxyModel::onSourceHeaderDataChanged(Qt::Orientation orientation, int first, int last)
+{
+    if (orientation == Qt::Horizontal) {
+        emit headerDataChanged(orientation, first, last);
+    } else if (rowCount() > 0) {
+        emit headerDataChanged(orientation, 0, rowCount() - 1);
+    }
+}
+
+void ConcurrentSortFilterProxyModel::onSourceRowsAboutToBeInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+
+    // 源顺序时原位插入；已排序或过滤时先追加到末尾，等后台重新计算
+    const int proxyFirst = m_isSourceOrder ? first : m_proxyToSource.size();
+    beginInsertRows(QModelIndex(), proxyFirst, proxyFirst + last - first);
+}
+
+void ConcurrentSortFilterProxyModel::onSourceRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+
+    const int count = last - first + 1;
+    for (int &row : m_proxyToSource) {
+        if (row >= first) {
+            row += count;
+        }
+    }
+
+    const int proxyFirst = m_isSourceOrder ? first : m_proxyToSource.size();
+    m_proxyToSource.insert(proxyFirst, count, 0);
+    for (int i = 0; i < count; ++i) {
+        m_proxyToSource[proxyFirst + i] = first + i;
+    }
+    rebuildSourceToProxy();
+
+    // 快照只补上新行，不重新读取其余行
+    QAbstractItemModel *model = sourceModel();
+    const int sortColumn = m_sortColumn;
+    const int sortRole = m_sortRole;
+    patchSnapshot(m_sortSnapshot, [=](QVector<SortKey> &keys) {
+        keys.insert(qMin(first, keys.size()), count, SortKey());
+        for (int row = first; row <= last && row < keys.size(); ++row) {
+            keys[row] = makeSortKey(model->index(row, sortColumn).data(sortRole));
+        }
+    });
+
+    const int filterColumn = m_filterKeyColumn;
+    const int filterRole = m_filterRole;
+    patchSnapshot(m_filterSnapshot, [=](QVector<QString> &keys) {
+        keys.insert(qMin(first, keys.size()), count, QString());
+        for (int row = first; row <= last && row < keys.size(); ++row) {
+            keys[row] = model->index(row, filterColumn).data(filterRole).toString();
+        }
+    });
+
+    endInsertRows();
+
+    // 进行中的计算基于旧行号，作废后重新发起；已排序或过滤时新行也需要放到正确位置
+    if (!m_isSourceOrder || m_isBusy) {
+        invalidate();
+    }
+}
+
+void ConcurrentSortFilterProxyModel::onSourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+
+    // 被删源行在代理中的位置
+    QVector<int> proxyRows;
+    proxyRows.reserve(last - first + 1);
+    for (int row = first; row <= last; ++row) {
+        const int proxyRow = m_sourceToProxy.value(row, -1);
+        if (proxyRow >= 0) {
+            proxyRows.append(proxyRow);
+        }
+    }
+    if (proxyRows.isEmpty()) {
+        return;
+    }
+    std::sort(proxyRows.begin(), proxyRows.end());
+
+    // 从后往前合并成连续区间，逐段删除时前面的行号不受影响
+    QVector<QPair<int, int>> ranges;
+    for (int i = proxyRows.size() - 1; i >= 0;) {
+        const int end = proxyRows.at(i);
+        int start = end;
+        while (--i >= 0 && proxyRows.at(i) == start - 1) {
+            start = proxyRows.at(i);
+        }
+        ranges.append(qMakePair(start, end));
+    }
+
+    // 源行号在 rowsRemoved 中统一修正，这里删代理行并同步反向映射，
+    // 每段删除通知期间两张映射表保持一致
+    if (ranges.size() <= kMaxRemovedRanges) {
+        for (const QPair<int, int> &range : ranges) {
+            beginRemoveRows(QModelIndex(), range.first, range.second);
+            for (int row = range.first; row <= range.second; ++row) {
+                m_sourceToProxy[m_proxyToSource.at(row)] = -1;
+            }
+            m_proxyToSource.remove(range.first, range.second - range.first + 1);
+            for (int row = range.first; row < m_proxyToSource.size(); ++row) {
+                m_sourceToProxy[m_proxyToSource.at(row)] = row;
+            }
+            endRemoveRows();
+        }
+        return;
+    }
+
+    // 分散在很多段时逐段删除是 O(段数 × 行数)，改为一次布局变化
+    emit layoutAboutToBeChanged();
+
+    QVector<int> newRows(m_proxyToSource.size(), 0);
+    for (int row : proxyRows) {
+        newRows[row] = -1;
+    }
+    int next = 0;
+    for (int row = 0; row < newRows.size(); ++row) {
+        if (newRows.at(row) == 0) {
+            newRows[row] = next;
+            m_proxyToSource[next] = m_proxyToSource.at(row);
+            ++next;
+        }
+    }
+    m_proxyToSource.resize(next);
+    rebuildSourceToProxy();
+
+    const QModelIndexList oldIndexes = persistentIndexList();
+    QModelIndexList newIndexes;
+    newIndexes.reserve(oldIndexes.size());
+    for (const QModelIndex &index : oldIndexes) {
+        const int row = newRows.value(index.row(), -1);
+        newIndexes << (row >= 0 ? createIndex(row, index.column()) : QModelIndex());
+    }
+    changePersistentIndexList(oldIndexes, newIndexes);
+
+    emit layoutChanged();
+}
+
+void ConcurrentSortFilterProxyModel::onSourceRowsRemoved(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+
+    // 删除不改变其余行的相对顺序和过滤结果，修正行号即可，不需要重新计算
+    const int count = last - first + 1;
+    for (int &row : m_proxyToSource) {
+        if (row > last) {
+            row -= count;
+        }
+    }
+    rebuildSourceToProxy();
+
+    patchSnapshot(m_sortSnapshot, [=](QVector<SortKey> &keys) {
+        if (first < keys.size()) {
+            keys.remove(first, qMin(count, keys.size() - first));
+        }
+    });
+    patchSnapshot(m_filterSnapshot, [=](QVector<QString> &keys) {
+        if (first < keys.size()) {
+            keys.remove(first, qMin(count, keys.size() - first));
+        }
+    });
+
+    if (m_isBusy) {
+        invalidate();
+    }
+}
+
+void ConcurrentSortFilterProxyModel::onSourceLayoutAboutToBeChanged()
+{
+    emit layoutAboutToBeChanged();
+
+    // 源模型的持久索引会随布局迁移，代理的持久索引借它们找到新位置
+    m_layoutProxyIndexes = persistentIndexList();
+    m_layoutSourceIndexes.clear();
+    m_layoutSourceIndexes.reserve(m_layoutProxyIndexes.size());
+    for (const QModelIndex &index : m_layoutProxyIndexes) {
+        m_layoutSourceIndexes << QPersistentModelIndex(mapToSource(index));
+    }
+
+    // 已排序或过滤的映射逐行记下源索引，变化后按原顺序重建，不退回源顺序
+    m_layoutRows.clear();
+    m_isLayoutTracked = !m_isSourceOrder && m_proxyToSource.size() <= kMaxTrackedLayoutRows;
+    if (m_isLayoutTracked) {
+        m_layoutRows.reserve(m_proxyToSource.size());
+        for (int row : m_proxyToSource) {
+            m_layoutRows << QPersistentModelIndex(sourceModel()->index(row, 0));
+        }
+    }
+}
+
+void ConcurrentSortFilterProxyModel::onSourceLayoutChanged()
+{
+    const bool wasSourceOrder = m_isSourceOrder;
+    if (m_isLayoutTracked) {
+        m_proxyToSource.clear();
+        m_proxyToSource.reserve(m_layoutRows.size());
+        for (const QPersistentModelIndex &index : m_layoutRows) {
+            if (index.isValid()) {
+                m_proxyToSource.append(index.row());
+            }
+        }
+        rebuildSourceToProxy();
+        invalidateSnapshots();
+    } else {
+        // 行数过多时不逐行跟踪，先按源顺序显示，由后台重新排序过滤
+        resetMapping();
+    }
+
+    QModelIndexList newIndexes;
+    newIndexes.reserve(m_layoutProxyIndexes.size());
+    for (int i = 0; i < m_layoutProxyIndexes.size(); ++i) {
+        const QModelIndex source = m_layoutSourceIndexes.at(i);
+        const QModelIndex index = mapFromSource(source);
+        newIndexes << (index.isValid() ? createIndex(index.row(), m_layoutProxyIndexes.at(i).column()) : QModelIndex());
+    }
+    changePersistentIndexList(m_layoutProxyIndexes, newIndexes);
+
+    m_layoutProxyIndexes.clear();
+    m_layoutSourceIndexes.clear();
+    m_layoutRows.clear();
+
+    emit layoutChanged();
+
+    if ((!m_isLayoutTracked && !wasSourceOrder) || m_isBusy) {
+        invalidate();
+    }
+    m_isLayoutTracked = false;
+}
+
+void ConcurrentSortFilterProxyModel::onSourceColumnsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+
+    // 快照按行保存，列号整体后移后仍然有效
+    const int count = last - first + 1;
+    if (m_sortColumn >= first) {
+        m_sortColumn += count;
+    }
+    if (m_filterKeyColumn >= first) {
+        m_filterKeyColumn += count;
+    }
+    endInsertColumns();
+}
+
+void ConcurrentSortFilterProxyModel::onSourceColumnsRemoved(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+
+    const int count = last - first + 1;
+    bool needsUpdate = false;
+    if (m_sortColumn >= first && m_sortColumn <= last) {
+        m_sortColumn = -1;
+        m_sortSnapshot.reset();
+        needsUpdate = true;
+    } else if (m_sortColumn > last) {
+        m_sortColumn -= count;
+    }
+
+    if (m_filterKeyColumn >= first && m_filterKeyColumn <= last) {
+        m_filterKeyColumn = -1;
+        m_filterSnapshot.reset();
+        needsUpdate = !m_filterString.isEmpty() || needsUpdate;
+    } else if (m_filterKeyColumn > last) {
+        m_filterKeyColumn -= count;
+    }
+    endRemoveColumns();
+
+    if (needsUpdate) {
+        invalidate();
+    }
+}
+
+void ConcurrentSortFilterProxyModel::onSourceColumnsMoved(const QModelIndex &parent, int start, int end,
+                                                          const QModelIndex &destination, int column)
+{
+    if (parent.isValid() || destination.isValid()) {
+        return;
+    }
+
+    m_sortColumn = m_sortColumn >= 0 ? movedSection(m_sortColumn, start, end, column) : -1;
+    m_filterKeyColumn = m_filterKeyColumn >= 0 ? movedSection(m_filterKeyColumn, start, end, column) : -1;
+    endMoveColumns();
+}
+
+void ConcurrentSortFilterProxyModel::onSourceModelReset()
+{
+    resetMapping();
+    endResetModel();
+    invalidate();
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <memory>
+
+#include <QVector>
+#include <QString>
+#include <QPersistentModelIndex>
+#include <QAbstractProxyModel>
+
+class QTimer;
+
+/**
+ * @brief 在线程池中排序、过滤的代理模型
+ *
+ * 只处理表格/列表这类扁平模型。排序列和过滤列在 GUI 线程取一次快照，
+ * 排序置换和过滤结果在 QThreadPool 中计算，完成后通过 layoutChanged 一次性替换映射，
+ * 选中状态随持久索引迁移。新的排序或过滤请求会让尚未完成的旧请求作废。
+ *
+ * 源模型增删行时按行转发插入/删除信号，快照只补上或去掉变化的行：新行先追加在末尾，
+ * 等后台重新排序过滤后再换到正确位置；删除行不影响其余行的顺序，不需要重新计算。
+ * 旧映射在新映射换入之前一直有效。
+ *
+ * TableView 的行高亮以行号记录，映射替换后需要用 TableRowStateSync 重新同步。
+ */
+class ConcurrentSortFilterProxyModel : public QAbstractProxyModel
+{
+    Q_OBJECT
+
+public:
+    explicit ConcurrentSortFilterProxyModel(QObject *parent = nullptr);
+    ~ConcurrentSortFilterProxyModel() override;
+
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
+
+    void setSortRole(int role);
+    int sortRole() const { return m_sortRole; }
+
+    void setSortCaseSensitivity(Qt::CaseSensitivity cs);
+    Qt::CaseSensitivity sortCaseSensitivity() const { return m_sortCaseSensitivity; }
+
+    void setFilterRole(int role);
+    int filterRole() const { return m_filterRole; }
+
+    void setFilterKeyColumn(int column);
+    int filterKeyColumn() const { return m_filterKeyColumn; }
+
+    void setFilterCaseSensitivity(Qt::CaseSensitivity cs);
+    Qt::CaseSensitivity filterCaseSensitivity() const { return m_filterCaseSensitivity; }
+
+    void setFilterFixedString(const QString &pattern);
+    QString filterFixedString() const { return m_filterString; }
+
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+    int sortColumn() const { return m_sortColumn; }
+    Qt::SortOrder sortOrder() const { return m_sortOrder; }
+
+    /**
+     * @brief 是否有后台请求尚未完成
+     */
+    bool isBusy() const { return m_isBusy; }
+
+    QModelIndex mapToSource(const QModelIndex &proxyIndex) const override;
+    QModelIndex mapFromSource(const QModelIndex &sourceIndex) const override;
+
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex &child) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+
+signals:
+    void busyChanged(bool busy);
+
+private:
+    // 排序键在快照时就转换好类型，工作线程中不再接触 QVariant
+    struct SortKey {
+        bool isNumber = false;
+        double number = 0;
+        QString text;
+    };
+    struct Shared;
+
+    static SortKey makeSortKey(const QVariant &value);
+
+    void invalidate();
+    void invalidateSnapshots();
+    void startJob();
+    void applyResult(int generation, const QVector<int> &rows, bool isSourceOrder);
+    void resetMapping();
+    void rebuildSourceToProxy();
+    void setBusy(bool busy);
+
+    void onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+    void onSourceHeaderDataChanged(Qt::Orientation orientation, int first, int last);
+    void onSourceRowsAboutToBeInserted(const QModelIndex &parent, int first, int last);
+    void onSourceRowsInserted(const QModelIndex &parent, int first, int last);
+    void onSourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+    void onSourceRowsRemoved(const QModelIndex &parent, int first, int last);
+    void onSourceLayoutAboutToBeChanged();
+    void onSourceLayoutChanged();
+    void onSourceColumnsInserted(const QModelIndex &parent, int first, int last);
+    void onSourceColumnsRemoved(const QModelIndex &parent, int first, int last);
+    void onSourceColumnsMoved(const QModelIndex &parent, int start, int end, const QModelIndex &destination, int column);
+    void onSourceModelReset();
+
+    std::shared_ptr<Shared> m_shared;
+    QTimer *m_scheduleTimer;
+
+    // 代理行 -> 源行；源行 -> 代理行，被过滤掉的为 -1
+    QVector<int> m_proxyToSource;
+    QVector<int> m_sourceToProxy;
+
+    // 映射是否就是源顺序（未排序、未过滤）
+    bool m_isSourceOrder;
+
+    // 源模型布局变化期间：代理持久索引及其源索引，以及逐行记录的源索引
+    QModelIndexList m_layoutProxyIndexes;
+    QList<QPersistentModelIndex> m_layoutSourceIndexes;
+    QList<QPersistentModelIndex> m_layoutRows;
+    bool m_isLayoutTracked;
+
+    // 排序列和过滤列的快照，数据变化时置空
+    std::shared_ptr<const QVector<SortKey>> m_sortSnapshot;
+    std::shared_ptr<const QVector<QString>> m_filterSnapshot;
+
+    int m_sortColumn;
+    Qt::SortOrder m_sortOrder;
+    int m_sortRole;
+    Qt::CaseSensitivity m_sortCaseSensitivity;
+
+    int m_filterKeyColumn;
+    int m_filterRole;
+    Qt::CaseSensitivity m_filterCaseSensitivity;
+    QString m_filterString;
+
+    bool m_isBusy;
+    QList<QMetaObject::Connection> m_sourceConnections;
+};
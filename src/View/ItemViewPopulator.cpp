@@ -0,0 +1,212 @@
+#include "ItemViewPopulator.h"
+
+#include <QTimer>
+#include <QListWidget>
+#include <QTableWidget>
+#include <QElapsedTimer>
+#include <QItemSelectionModel>
+
+namespace {
+// 时间片内每次插入的行数上下限。先插一小批测出单行耗时，再按剩余预算估算下一批，
+// 太小会让 rowsInserted 信号过多，太大则一批就可能超出时间片
+constexpr int kMinBatchRows = 16;
+constexpr int kMaxBatchRows = 1024;
+}
+
+ItemViewPopulator::ItemViewPopulator(QListWidget *view)
+    : QObject(view)
+    , m_listWidget(view)
+    , m_view(view)
+    , m_position(0)
+    , m_inserted(0)
+    , m_total(0)
+    , m_timeSlice(8)
+    , m_isRunning(false)
+    , m_runId(0)
+    , m_wasSortingEnabled(false)
+    , m_oldLayoutMode(QListView::SinglePass)
+{
+}
+
+ItemViewPopulator::ItemViewPopulator(QTableWidget *view)
+    : QObject(view)
+    , m_tableWidget(view)
+    , m_view(view)
+    , m_position(0)
+    , m_inserted(0)
+    , m_total(0)
+    , m_timeSlice(8)
+    , m_isRunning(false)
+    , m_runId(0)
+    , m_wasSortingEnabled(false)
+    , m_oldLayoutMode(QListView::SinglePass)
+{
+}
+
+void ItemViewPopulator::setTimeSlice(int msecs)
+{
+    m_timeSlice = qMax(1, msecs);
+}
+
+void ItemViewPopulator::append(const QStringList &rows)
+{
+    if (!m_listWidget || rows.isEmpty()) {
+        return;
+    }
+    m_pendingTexts += rows;
+    m_total += rows.size();
+    start();
+}
+
+void ItemViewPopulator::append(const QVector<QStringList> &rows)
+{
+    if (!m_tableWidget || rows.isEmpty()) {
+        return;
+    }
+    m_pendingRows += rows;
+    m_total += rows.size();
+    start();
+}
+
+void ItemViewPopulator::cancel()
+{
+    if (!m_isRunning) {
+        return;
+    }
+    m_pendingTexts.clear();
+    m_pendingRows.clear();
+    finish();
+}
+
+void ItemViewPopulator::start()
+{
+    if (m_isRunning) {
+        return;
+    }
+    m_isRunning = true;
+
+    // 逐行排序和逐行布局是大批量插入的主要开销，填充结束后再恢复
+    if (m_tableWidget) {
+        m_wasSortingEnabled = m_tableWidget->isSortingEnabled();
+        m_tableWidget->setSortingEnabled(false);
+    } else if (m_listWidget) {
+        m_wasSortingEnabled = m_listWidget->isSortingEnabled();
+        m_listWidget->setSortingEnabled(false);
+        m_oldLayoutMode = m_listWidget->layoutMode();
+        m_listWidget->setLayoutMode(QListView::Batched);
+    }
+
+    // 第一片同步插入，调用方返回后即可看到内容
+    processChunk();
+}
+
+void ItemViewPopulator::processChunk()
+{
+    if (!m_isRunning || !m_view) {
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    suspendView();
+    const int pending = m_listWidget ? m_pendingTexts.size() : m_pendingRows.size();
+    const qint64 budget = qint64(m_timeSlice) * 1000000;
+    int sliceRows = 0;
+    int batchRows = kMinBatchRows;
+    while (m_position < pending) {
+        const int count = qMin(batchRows, pending - m_position);
+        if (m_listWidget) {
+            insertListRows(count);
+        } else {
+            insertTableRows(count);
+        }
+        m_position += count;
+        m_inserted += count;
+        sliceRows += count;
+
+        const qint64 elapsed = timer.nsecsElapsed();
+        if (elapsed >= budget) {
+            break;
+        }
+        // 按本片已测得的单行耗时，把下一批控制在剩余预算之内
+        const qint64 affordable = elapsed > 0 ? (budget - elapsed) * sliceRows / elapsed : kMaxBatchRows;
+        batchRows = int(qBound<qint64>(kMinBatchRows, affordable, kMaxBatchRows));
+    }
+    resumeView();
+
+    emit progressChanged(m_inserted, m_total);
+
+    if (m_position < pending) {
+        // 取消后又重新开始时，旧的排队回调不能再插入
+        const int runId = m_runId;
+        QTimer::singleShot(0, this, [this, runId]() {
+            if (runId == m_runId) {
+                processChunk();
+            }
+        });
+        return;
+    }
+    finish();
+}
+
+void ItemViewPopulator::insertListRows(int count)
+{
+    // addItems 一次只发出一个 rowsInserted
+    m_listWidget->addItems(m_pendingTexts.mid(m_position, count));
+}
+
+void ItemViewPopulator::insertTableRows(int count)
+{
+    const int firstRow = m_tableWidget->rowCount();
+    m_tableWidget->setRowCount(firstRow + count);
+
+    for (int i = 0; i < count; ++i) {
+        const QStringList &cells = m_pendingRows.at(m_position + i);
+        if (cells.size() > m_tableWidget->columnCount()) {
+            m_tableWidget->setColumnCount(cells.size());
+        }
+        for (int column = 0; column < cells.size(); ++column) {
+            m_tableWidget->setItem(firstRow + i, column, new QTableWidgetItem(cells.at(column)));
+        }
+    }
+}
+
+void ItemViewPopulator::suspendView()
+{
+    m_view->setUpdatesEnabled(false);
+    if (m_view->selectionModel()) {
+        m_view->selectionModel()->blockSignals(true);
+    }
+}
+
+void ItemViewPopulator::resumeView()
+{
+    if (m_view->selectionModel()) {
+        m_view->selectionModel()->blockSignals(false);
+    }
+    m_view->setUpdatesEnabled(true);
+}
+
+void ItemViewPopulator::finish()
+{
+    ++m_runId;
+    m_isRunning = false;
+    m_pendingTexts.clear();
+    m_pendingRows.clear();
+    m_position = 0;
+
+    if (m_tableWidget) {
+        m_tableWidget->setSortingEnabled(m_wasSortingEnabled);
+    } else if (m_listWidget) {
+        m_listWidget->setLayoutMode(static_cast<QListView::LayoutMode>(m_oldLayoutMode));
+        m_listWidget->setSortingEnabled(m_wasSortingEnabled);
+    }
+
+    const bool completed = m_inserted == m_total;
+    m_inserted = 0;
+    m_total = 0;
+    if (completed) {
+        emit finished();
+    }
+}
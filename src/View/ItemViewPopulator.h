@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+#include <QStringList>
+#include <QAbstractItemView>
+
+class QListWidget;
+class QTableWidget;
+
+/**
+ * @brief ListWidget / TableWidget 的分批填充器
+ *
+ * 一次提交大量行，按时间片分多轮事件循环插入。每一片插入期间暂停视图刷新和
+ * 选择模型信号，片与片之间让出事件循环，界面保持响应；第一片在 append 中同步完成，
+ * 调用返回后即可看到内容。
+ */
+class ItemViewPopulator : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ItemViewPopulator(QListWidget *view);
+    explicit ItemViewPopulator(QTableWidget *view);
+
+    /**
+     * @brief 设置每轮事件循环的插入时间预算（毫秒）
+     */
+    void setTimeSlice(int msecs);
+    int timeSlice() const { return m_timeSlice; }
+
+    /**
+     * @brief 追加列表行，仅适用于 QListWidget
+     */
+    void append(const QStringList &rows);
+
+    /**
+     * @brief 追加表格行，每行按列给出文本，仅适用于 QTableWidget
+     */
+    void append(const QVector<QStringList> &rows);
+
+    void cancel();
+    bool isRunning() const { return m_isRunning; }
+
+signals:
+    void progressChanged(int inserted, int total);
+    void finished();
+
+private:
+    void start();
+    void processChunk();
+    void insertListRows(int count);
+    void insertTableRows(int count);
+    void suspendView();
+    void resumeView();
+    void finish();
+
+    QPointer<QListWidget> m_listWidget;
+    QPointer<QTableWidget> m_tableWidget;
+    QAbstractItemView *m_view;
+
+    QStringList m_pendingTexts;
+    QVector<QStringList> m_pendingRows;
+    int m_position;
+    int m_inserted;
+    int m_total;
+
+    int m_timeSlice;
+    bool m_isRunning;
+    int m_runId;
+
+    // 填充期间临时修改、结束后恢复的视图设置
+    bool m_wasSortingEnabled;
+    int m_oldLayoutMode;
+};
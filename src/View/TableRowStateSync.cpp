@@ -0,0 +1,80 @@
+#include "TableRowStateSync.h"
+
+#include <QTimer>
+#include <QCursor>
+#include <QKeyEvent>
+#include <QCoreApplication>
+#include <QAbstractItemView>
+#include <QAbstractItemModel>
+
+TableRowStateSync::TableRowStateSync(QAbstractItemView *view)
+    : QObject(view)
+    , m_view(view)
+    , m_pressedRow(-1)
+    , m_syncTimer(new QTimer(this))
+{
+    m_syncTimer->setSingleShot(true);
+    m_syncTimer->setInterval(0);
+    connect(m_syncTimer, &QTimer::timeout, this, &TableRowStateSync::sync);
+
+    // 与 TableBase 记录按下行的时机相同，持久索引会随布局变化移动到新行号
+    connect(view, &QAbstractItemView::pressed, this, [this](const QModelIndex &index) {
+        m_pressedIndex = index;
+        m_pressedRow = index.row();
+    });
+
+    bindModel(view->model());
+}
+
+void TableRowStateSync::bindModel(QAbstractItemModel *model)
+{
+    for (const QMetaObject::Connection &connection : m_modelConnections) {
+        disconnect(connection);
+    }
+    m_modelConnections.clear();
+    m_model = model;
+
+    if (!model) {
+        return;
+    }
+
+    auto scheduleSync = [this]() { m_syncTimer->start(); };
+    m_modelConnections << connect(model, &QAbstractItemModel::layoutChanged, this, scheduleSync);
+    m_modelConnections << connect(model, &QAbstractItemModel::rowsInserted, this, scheduleSync);
+    m_modelConnections << connect(model, &QAbstractItemModel::rowsRemoved, this, scheduleSync);
+    m_modelConnections << connect(model, &QAbstractItemModel::rowsMoved, this, scheduleSync);
+    m_modelConnections << connect(model, &QAbstractItemModel::modelReset, this, scheduleSync);
+}
+
+void TableRowStateSync::sync()
+{
+    if (!m_view) {
+        return;
+    }
+
+    if (m_view->model() != m_model) {
+        bindModel(m_view->model());
+    }
+
+    // 悬停跟随光标而不是原来的数据行；TableBase 和 CachedTableItemDelegate 都从 entered 更新悬停行
+    QWidget *viewport = m_view->viewport();
+    const QPoint pos = viewport->mapFromGlobal(QCursor::pos());
+    emit m_view->entered(viewport->underMouse() ? m_view->indexAt(pos) : QModelIndex());
+
+    // 按下的行换了行号或已被删除时，重发 pressed 让 TableBase 改记新行号（无效索引即清除）
+    const int pressedRow = m_pressedIndex.isValid() ? m_pressedIndex.row() : -1;
+    if (m_pressedRow >= 0 && pressedRow != m_pressedRow) {
+        const QModelIndex index = m_pressedIndex;
+        emit m_view->pressed(index);
+        m_pressedRow = pressedRow;
+    }
+
+    // 选择模型已随持久索引迁移。TableBase 没有公开的刷新接口，只在键盘、鼠标和选择函数之后
+    // 重新读取选中行；这里发送一个不做任何操作的按键，借 keyPressEvent 重新读取
+    if (m_view->selectionMode() != QAbstractItemView::NoSelection) {
+        QKeyEvent event(QEvent::KeyPress, Qt::Key_unknown, Qt::NoModifier);
+        QCoreApplication::sendEvent(m_view, &event);
+    }
+
+    viewport->update();
+}
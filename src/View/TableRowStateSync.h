@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QPersistentModelIndex>
+
+class QTimer;
+class QAbstractItemView;
+class QAbstractItemModel;
+
+/**
+ * @brief 模型行号变化后重新同步 TableView 中的悬停、按下和选中行
+ *
+ * TableBase 的代理以行号记录这些状态，只在鼠标和键盘操作时更新，
+ * 模型布局变化或增删行之后旧行号会落到别的行上。同步器把按下的行记为持久索引，
+ * 变化后只通过视图的公开接口重新同步：按光标位置重发 entered、按新行号重发 pressed，
+ * 再让 TableBase 从选择模型重新读取选中行，最后刷新视口。
+ *
+ * 需要在 view->setModel() 之后创建，同步在事件循环中合并执行，晚于选择模型自身的迁移。
+ */
+class TableRowStateSync : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TableRowStateSync(QAbstractItemView *view);
+
+    /**
+     * @brief 立即同步一次
+     */
+    void sync();
+
+private:
+    void bindModel(QAbstractItemModel *model);
+
+    QPointer<QAbstractItemView> m_view;
+    QPointer<QAbstractItemModel> m_model;
+    QList<QMetaObject::Connection> m_modelConnections;
+    QPersistentModelIndex m_pressedIndex;
+    int m_pressedRow;
+    QTimer *m_syncTimer;
+};
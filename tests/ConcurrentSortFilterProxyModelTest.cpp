@@ -0,0 +1,244 @@
+#include "ConcurrentSortFilterProxyModelTest.h"
+
+#include <QtTest>
+#include <QStandardItemModel>
+#include <QAbstractItemModelTester>
+
+#include "View/ConcurrentSortFilterProxyModel.h"
+
+namespace {
+// 超过后台排序的分块大小，覆盖分块排序后的归并
+constexpr int kRowCount = 10000;
+constexpr int kLargeRowCount = 50000;
+constexpr int kValueModulus = 997;
+constexpr int kIdColumn = 0;
+constexpr int kValueColumn = 1;
+constexpr int kRemovedBlockFirst = 1000;
+constexpr int kRemovedBlockSize = 200;
+
+using FailureMode = QAbstractItemModelTester::FailureReportingMode;
+
+// 取值有大量重复，排序结果还能检查稳定性
+int valueOf(int id)
+{
+    return int((qint64(id) * 7919) % kValueModulus);
+}
+
+QList<QStandardItem *> makeRow(int id)
+{
+    auto idItem = new QStandardItem(QStringLiteral("item-%1").arg(id));
+    idItem->setData(id, Qt::UserRole);
+    auto valueItem = new QStandardItem;
+    valueItem->setData(valueOf(id), Qt::DisplayRole);
+    return {idItem, valueItem};
+}
+
+void fillModel(QStandardItemModel &model, int rowCount)
+{
+    model.setColumnCount(2);
+    for (int id = 0; id < rowCount; ++id) {
+        model.appendRow(makeRow(id));
+    }
+}
+
+int idAt(const QAbstractItemModel &model, int row)
+{
+    return model.index(row, kIdColumn).data(Qt::UserRole).toInt();
+}
+
+int valueAt(const QAbstractItemModel &model, int row)
+{
+    return model.index(row, kValueColumn).data().toInt();
+}
+
+/**
+ * @brief 按取值有序，取值相同的行保持源模型中的先后顺序
+ */
+bool isStablySorted(const ConcurrentSortFilterProxyModel &proxy, Qt::SortOrder order)
+{
+    for (int row = 1; row < proxy.rowCount(); ++row) {
+        const int previous = valueAt(proxy, row - 1);
+        const int current = valueAt(proxy, row);
+        if (previous == current) {
+            if (proxy.mapToSource(proxy.index(row - 1, 0)).row() > proxy.mapToSource(proxy.index(row, 0)).row()) {
+                return false;
+            }
+        } else if (order == Qt::AscendingOrder ? previous > current : previous < current) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 正反两张映射表一一对应
+ */
+bool isMappingConsistent(const ConcurrentSortFilterProxyModel &proxy)
+{
+    for (int row = 0; row < proxy.rowCount(); ++row) {
+        const QModelIndex source = proxy.mapToSource(proxy.index(row, 0));
+        if (!source.isValid() || proxy.mapFromSource(source).row() != row) {
+            return false;
+        }
+    }
+
+    const QAbstractItemModel *model = proxy.sourceModel();
+    int mappedCount = 0;
+    for (int row = 0; row < model->rowCount(); ++row) {
+        const QModelIndex index = proxy.mapFromSource(model->index(row, 0));
+        if (!index.isValid()) {
+            continue;
+        }
+        ++mappedCount;
+        if (proxy.mapToSource(index).row() != row) {
+            return false;
+        }
+    }
+    return mappedCount == proxy.rowCount();
+}
+
+int matchingCount(const QAbstractItemModel &model, const QString &pattern)
+{
+    int count = 0;
+    for (int row = 0; row < model.rowCount(); ++row) {
+        if (model.index(row, kIdColumn).data().toString().contains(pattern, Qt::CaseInsensitive)) {
+            ++count;
+        }
+    }
+    return count;
+}
+}
+
+void ConcurrentSortFilterProxyModelTest::filterAndSort()
+{
+    QStandardItemModel model;
+    fillModel(model, kRowCount);
+
+    ConcurrentSortFilterProxyModel proxy;
+    proxy.setSourceModel(&model);
+    QAbstractItemModelTester tester(&proxy, FailureMode::QtTest);
+    QSignalSpy busySpy(&proxy, &ConcurrentSortFilterProxyModel::busyChanged);
+
+    const QString pattern = QStringLiteral("1");
+    proxy.setFilterFixedString(pattern);
+    QTRY_VERIFY(!busySpy.isEmpty() && !proxy.isBusy());
+    QCOMPARE(proxy.rowCount(), matchingCount(model, pattern));
+    for (int row = 0; row < proxy.rowCount(); ++row) {
+        QVERIFY(proxy.index(row, kIdColumn).data().toString().contains(pattern));
+    }
+    QVERIFY(isMappingConsistent(proxy));
+
+    busySpy.clear();
+    proxy.sort(kValueColumn, Qt::AscendingOrder);
+    QTRY_VERIFY(!busySpy.isEmpty() && !proxy.isBusy());
+    QCOMPARE(proxy.rowCount(), matchingCount(model, pattern));
+    QVERIFY(isStablySorted(proxy, Qt::AscendingOrder));
+    QVERIFY(isMappingConsistent(proxy));
+
+    busySpy.clear();
+    proxy.setFilterFixedString(QString());
+    proxy.sort(kValueColumn, Qt::DescendingOrder);
+    QTRY_VERIFY(!busySpy.isEmpty() && !proxy.isBusy());
+    QCOMPARE(proxy.rowCount(), kRowCount);
+    QVERIFY(isStablySorted(proxy, Qt::DescendingOrder));
+    QVERIFY(isMappingConsistent(proxy));
+}
+
+void ConcurrentSortFilterProxyModelTest::insertRowsWhileSorted()
+{
+    QStandardItemModel model;
+    fillModel(model, kRowCount);
+
+    ConcurrentSortFilterProxyModel proxy;
+    proxy.setSourceModel(&model);
+    QAbstractItemModelTester tester(&proxy, FailureMode::QtTest);
+    QSignalSpy busySpy(&proxy, &ConcurrentSortFilterProxyModel::busyChanged);
+
+    proxy.sort(kValueColumn);
+    QTRY_VERIFY(!busySpy.isEmpty() && !proxy.isBusy());
+
+    // 新行先追加在代理末尾，重新排序后换到正确位置
+    busySpy.clear();
+    model.appendRow(makeRow(kRowCount));
+    model.insertRow(0, makeRow(kRowCount + 1));
+    model.insertRow(kRowCount / 2, makeRow(kRowCount + 2));
+    QCOMPARE(proxy.rowCount(), kRowCount + 3);
+    QVERIFY(isMappingConsistent(proxy));
+
+    QTRY_VERIFY(!busySpy.isEmpty() && !proxy.isBusy());
+    QCOMPARE(proxy.rowCount(), kRowCount + 3);
+    QVERIFY(isMappingConsistent(proxy));
+
+    // 取值相同时按源顺序，不能用插入前的顺序判断稳定性，这里只检查有序
+    for (int row = 1; row < proxy.rowCount(); ++row) {
+        QVERIFY(valueAt(proxy, row - 1) <= valueAt(proxy, row));
+    }
+}
+
+void ConcurrentSortFilterProxyModelTest::removeRowsWhileSorted()
+{
+    QStandardItemModel model;
+    fillModel(model, kRowCount);
+
+    ConcurrentSortFilterProxyModel proxy;
+    proxy.setSourceModel(&model);
+    QAbstractItemModelTester tester(&proxy, FailureMode::QtTest);
+    QSignalSpy busySpy(&proxy, &ConcurrentSortFilterProxyModel::busyChanged);
+
+    proxy.sort(kValueColumn);
+    QTRY_VERIFY(!busySpy.isEmpty() && !proxy.isBusy());
+
+    // 代理发出 rowsRemoved 时两张映射表必须已经一致
+    int checkedCount = 0;
+    bool isConsistent = true;
+    connect(&proxy, &QAbstractItemModel::rowsRemoved, &proxy, [&]() {
+        ++checkedCount;
+        isConsistent = isConsistent && isMappingConsistent(proxy);
+    });
+
+    // 单行：代理中只有一段，逐段删除
+    const int removedId = idAt(model, 0);
+    QVERIFY(model.removeRow(0));
+    QCOMPARE(checkedCount, 1);
+    QVERIFY(isConsistent);
+    QCOMPARE(proxy.rowCount(), kRowCount - 1);
+    for (int row = 0; row < proxy.rowCount(); ++row) {
+        QVERIFY(idAt(proxy, row) != removedId);
+    }
+
+    // 连续的源行在排序后分散成很多段，改为一次布局变化
+    QSignalSpy layoutSpy(&proxy, &QAbstractItemModel::layoutChanged);
+    QVERIFY(model.removeRows(kRemovedBlockFirst, kRemovedBlockSize));
+    QCOMPARE(layoutSpy.count(), 1);
+    QCOMPARE(proxy.rowCount(), kRowCount - 1 - kRemovedBlockSize);
+    QVERIFY(isMappingConsistent(proxy));
+    QVERIFY(isStablySorted(proxy, Qt::AscendingOrder));
+    QVERIFY(!proxy.isBusy());
+}
+
+void ConcurrentSortFilterProxyModelTest::cancelledSortIsDiscarded()
+{
+    QStandardItemModel model;
+    fillModel(model, kLargeRowCount);
+
+    ConcurrentSortFilterProxyModel proxy;
+    proxy.setSourceModel(&model);
+    QAbstractItemModelTester tester(&proxy, FailureMode::QtTest);
+    QSignalSpy busySpy(&proxy, &ConcurrentSortFilterProxyModel::busyChanged);
+    QSignalSpy layoutSpy(&proxy, &QAbstractItemModel::layoutChanged);
+
+    // 第一次排序在后台开始后立即被新的请求作废
+    proxy.sort(kValueColumn, Qt::AscendingOrder);
+    QTRY_VERIFY(proxy.isBusy());
+    proxy.sort(kValueColumn, Qt::DescendingOrder);
+
+    QTRY_VERIFY(!proxy.isBusy());
+    QCOMPARE(busySpy.count(), 2);
+
+    // 作废的结果即使已经投递也不会应用，只换入一次映射
+    QTest::qWait(0);
+    QCOMPARE(layoutSpy.count(), 1);
+    QCOMPARE(proxy.rowCount(), kLargeRowCount);
+    QVERIFY(isStablySorted(proxy, Qt::DescendingOrder));
+    QVERIFY(isMappingConsistent(proxy));
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <QObject>
+
+/**
+ * @brief ConcurrentSortFilterProxyModel 在过滤、排序、增删行和作废排序下的模型一致性
+ */
+class ConcurrentSortFilterProxyModelTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void filterAndSort();
+    void insertRowsWhileSorted();
+    void removeRowsWhileSorted();
+    void cancelledSortIsDiscarded();
+};
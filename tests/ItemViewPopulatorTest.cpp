@@ -0,0 +1,104 @@
+#include "ItemViewPopulatorTest.h"
+
+#include <QtTest>
+#include <QListWidget>
+#include <QTableWidget>
+
+#include "View/ItemViewPopulator.h"
+
+namespace {
+constexpr int kListRowCount = 20000;
+constexpr int kTableRowCount = 5000;
+constexpr int kTableColumnCount = 3;
+constexpr int kTimeout = 10000;
+}
+
+void ItemViewPopulatorTest::listBulkInsertLandsEveryRow()
+{
+    QListWidget view;
+    view.setSortingEnabled(true);
+    ItemViewPopulator populator(&view);
+    QSignalSpy finishedSpy(&populator, &ItemViewPopulator::finished);
+    QSignalSpy progressSpy(&populator, &ItemViewPopulator::progressChanged);
+
+    QStringList rows;
+    rows.reserve(kListRowCount);
+    for (int i = 0; i < kListRowCount; ++i) {
+        rows.append(QStringLiteral("row %1").arg(i, 5, 10, QLatin1Char('0')));
+    }
+    populator.append(rows);
+
+    // 第一片在 append 中同步完成
+    QVERIFY(view.count() > 0);
+
+    QTRY_COMPARE_WITH_TIMEOUT(finishedSpy.count(), 1, kTimeout);
+    QCOMPARE(view.count(), kListRowCount);
+    for (int i = 0; i < kListRowCount; ++i) {
+        if (view.item(i)->text() != rows.at(i)) {
+            QFAIL(qPrintable(QStringLiteral("row %1 out of order").arg(i)));
+        }
+    }
+
+    const QList<QVariant> lastProgress = progressSpy.last();
+    QCOMPARE(lastProgress.at(0).toInt(), kListRowCount);
+    QCOMPARE(lastProgress.at(1).toInt(), kListRowCount);
+    QVERIFY(!populator.isRunning());
+    QVERIFY(view.isSortingEnabled());
+    QCOMPARE(view.layoutMode(), QListView::SinglePass);
+}
+
+void ItemViewPopulatorTest::tableBulkInsertLandsEveryRow()
+{
+    QTableWidget view;
+    ItemViewPopulator populator(&view);
+    QSignalSpy finishedSpy(&populator, &ItemViewPopulator::finished);
+
+    QVector<QStringList> rows;
+    rows.reserve(kTableRowCount);
+    for (int i = 0; i < kTableRowCount; ++i) {
+        QStringList cells;
+        for (int column = 0; column < kTableColumnCount; ++column) {
+            cells.append(QStringLiteral("%1-%2").arg(i).arg(column));
+        }
+        rows.append(cells);
+    }
+
+    // 分两次提交，第二次在填充进行中追加
+    populator.append(rows.mid(0, kTableRowCount / 2));
+    populator.append(rows.mid(kTableRowCount / 2));
+
+    QTRY_COMPARE_WITH_TIMEOUT(finishedSpy.count(), 1, kTimeout);
+    QCOMPARE(view.rowCount(), kTableRowCount);
+    QCOMPARE(view.columnCount(), kTableColumnCount);
+    for (int i = 0; i < kTableRowCount; ++i) {
+        for (int column = 0; column < kTableColumnCount; ++column) {
+            const QTableWidgetItem *item = view.item(i, column);
+            if (!item || item->text() != rows.at(i).at(column)) {
+                QFAIL(qPrintable(QStringLiteral("cell %1,%2 missing").arg(i).arg(column)));
+            }
+        }
+    }
+}
+
+void ItemViewPopulatorTest::cancelStopsInsertion()
+{
+    QListWidget view;
+    ItemViewPopulator populator(&view);
+    QSignalSpy finishedSpy(&populator, &ItemViewPopulator::finished);
+
+    QStringList rows;
+    rows.reserve(kListRowCount);
+    for (int i = 0; i < kListRowCount; ++i) {
+        rows.append(QString::number(i));
+    }
+    populator.append(rows);
+    populator.cancel();
+
+    const int count = view.count();
+    QVERIFY(!populator.isRunning());
+
+    // 已排队的下一片不再插入
+    QTest::qWait(50);
+    QCOMPARE(view.count(), count);
+    QCOMPARE(finishedSpy.count(), count == kListRowCount ? 1 : 0);
+}
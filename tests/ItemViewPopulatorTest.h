@@ -0,0 +1,16 @@
+#pragma once
+
+#include <QObject>
+
+/**
+ * @brief ItemViewPopulator 分批填充：大批量插入的行全部按序落到视图，且视图设置被恢复
+ */
+class ItemViewPopulatorTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void listBulkInsertLandsEveryRow();
+    void tableBulkInsertLandsEveryRow();
+    void cancelStopsInsertion();
+};
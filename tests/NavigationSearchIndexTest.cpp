@@ -0,0 +1,106 @@
+#include "NavigationSearchIndexTest.h"
+
+#include <QtTest>
+
+#include "Navigation/NavigationSearchIndex.h"
+
+namespace {
+constexpr int kItemCount = 10000;
+
+QStringList vocabulary()
+{
+    return {
+        QStringLiteral("Orders"), QStringLiteral("Inventory"), QStringLiteral("Payments"),
+        QStringLiteral("Customers"), QStringLiteral("Reports"), QStringLiteral("Settings"),
+        QStringLiteral("Shipping"), QStringLiteral("Returns"), QStringLiteral("Coupons"),
+        QStringLiteral("Analytics"), QStringLiteral("订单"), QStringLiteral("库存"),
+        QStringLiteral("支付"), QStringLiteral("客户"), QStringLiteral("报表"),
+        QStringLiteral("物流"), QStringLiteral("退款"), QStringLiteral("优惠券")
+    };
+}
+
+QString itemKey(int i)
+{
+    return QStringLiteral("page-%1").arg(i);
+}
+
+QString itemText(int i)
+{
+    static const QStringList words = vocabulary();
+    return QStringLiteral("%1 %2 %3")
+            .arg(words.at(i % words.size()), words.at((i / words.size()) % words.size()))
+            .arg(i);
+}
+
+void fillIndex(NavigationSearchIndex *index)
+{
+    for (int i = 0; i < kItemCount; ++i) {
+        index->insert(itemKey(i), itemText(i));
+    }
+}
+}
+
+void NavigationSearchIndexTest::prefixMatchesComeFirst()
+{
+    NavigationSearchIndex index;
+    index.insert(QStringLiteral("a"), QStringLiteral("Sales Orders"));
+    index.insert(QStringLiteral("b"), QStringLiteral("Orders"));
+    index.insert(QStringLiteral("c"), QStringLiteral("Reports"));
+
+    QCOMPARE(index.search(QStringLiteral("order")), QStringList({QStringLiteral("b"), QStringLiteral("a")}));
+    QCOMPARE(index.search(QStringLiteral("ORDERS"), 1), QStringList({QStringLiteral("b")}));
+    QCOMPARE(index.search(QStringLiteral("r")), QStringList({QStringLiteral("c")}));
+    QVERIFY(index.search(QStringLiteral("xyz")).isEmpty());
+}
+
+void NavigationSearchIndexTest::removeDropsEntry()
+{
+    NavigationSearchIndex index;
+    index.insert(QStringLiteral("a"), QStringLiteral("Orders"));
+    index.insert(QStringLiteral("b"), QStringLiteral("Orders archive"));
+    index.remove(QStringLiteral("a"));
+
+    QCOMPARE(index.size(), 1);
+    QVERIFY(!index.contains(QStringLiteral("a")));
+    QCOMPARE(index.search(QStringLiteral("orders")), QStringList({QStringLiteral("b")}));
+}
+
+void NavigationSearchIndexTest::tenThousandItemsMatchBruteForce_data()
+{
+    QTest::addColumn<QString>("query");
+
+    QTest::newRow("single character") << QStringLiteral("r");
+    QTest::newRow("prefix") << QStringLiteral("ord");
+    QTest::newRow("substring") << QStringLiteral("ventory");
+    QTest::newRow("two words") << QStringLiteral("orders inv");
+    QTest::newRow("route key") << QStringLiteral("page-4321");
+    QTest::newRow("number") << QStringLiteral("9999");
+    QTest::newRow("cjk") << QStringLiteral("库存");
+    QTest::newRow("no match") << QStringLiteral("zzzz");
+}
+
+void NavigationSearchIndexTest::tenThousandItemsMatchBruteForce()
+{
+    QFETCH(QString, query);
+
+    NavigationSearchIndex index;
+    fillIndex(&index);
+    QCOMPARE(index.size(), kItemCount);
+
+    // 结果与逐项匹配一致：单个字符只匹配前缀，更长的查询匹配子串；耗时见 NavigationSearchIndexBenchmark
+    const QStringList keys = index.search(query);
+    const auto matches = [&query](const QString &term) {
+        return query.size() == 1 ? term.startsWith(query, Qt::CaseInsensitive)
+                                 : term.contains(query, Qt::CaseInsensitive);
+    };
+    int expected = 0;
+    for (int i = 0; i < kItemCount; ++i) {
+        if (matches(itemText(i)) || matches(itemKey(i))) {
+            ++expected;
+        }
+    }
+    QCOMPARE(keys.size(), expected);
+
+    // 重复查询走同一份索引，结果不变
+    QCOMPARE(index.search(query), keys);
+}
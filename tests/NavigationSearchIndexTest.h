@@ -0,0 +1,17 @@
+#pragma once
+
+#include <QObject>
+
+/**
+ * @brief NavigationSearchIndex 的匹配顺序与 10000 项下的查询结果
+ */
+class NavigationSearchIndexTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void prefixMatchesComeFirst();
+    void removeDropsEntry();
+    void tenThousandItemsMatchBruteForce_data();
+    void tenThousandItemsMatchBruteForce();
+};
@@ -0,0 +1,99 @@
+#include "RouteHistoryTest.h"
+
+#include <QtTest>
+#include <QRandomGenerator>
+
+#include "QFluent/StackedWidget.h"
+#include "Router/RouteHistory.h"
+
+namespace {
+constexpr int kCapacity = 256;
+constexpr int kNavigationCount = 1000000;
+constexpr int kKeyCount = 5000;
+
+QString routeKey(int index)
+{
+    return QStringLiteral("page-%1").arg(index % kKeyCount);
+}
+}
+
+void RouteHistoryTest::popMergesAdjacentAfterRemove()
+{
+    RouteRing ring(kCapacity);
+    QVERIFY(ring.push(RouteItem(nullptr, QStringLiteral("a"))));
+    QVERIFY(ring.push(RouteItem(nullptr, QStringLiteral("b"))));
+    QVERIFY(ring.push(RouteItem(nullptr, QStringLiteral("a"))));
+    QVERIFY(!ring.push(RouteItem(nullptr, QStringLiteral("a"))));
+
+    QCOMPARE(ring.remove(QStringLiteral("b")), 1);
+    QCOMPARE(ring.size(), 2);
+    QCOMPARE(ring.keyCount(), 1);
+
+    // 删除 b 后两条 a 相邻，整组弹出
+    RouteItem item;
+    QVERIFY(ring.pop(&item));
+    QCOMPARE(item.routeKey, QStringLiteral("a"));
+    QVERIFY(ring.isEmpty());
+    QCOMPARE(ring.keyCount(), 0);
+}
+
+void RouteHistoryTest::millionPushesStayBounded()
+{
+    RouteRing ring(kCapacity);
+    for (int i = 0; i < kNavigationCount; ++i) {
+        ring.push(RouteItem(nullptr, routeKey(i)));
+        if (ring.size() > kCapacity || ring.keyCount() > ring.size()) {
+            QFAIL(qPrintable(QStringLiteral("bound exceeded after %1 pushes: size %2, keys %3")
+                             .arg(i + 1).arg(ring.size()).arg(ring.keyCount())));
+        }
+    }
+
+    QCOMPARE(ring.size(), kCapacity);
+    QVERIFY(ring.keyCount() <= kCapacity);
+    QCOMPARE(ring.top().routeKey, routeKey(kNavigationCount - 1));
+}
+
+void RouteHistoryTest::mixedOperationsStayBounded()
+{
+    RouteRing ring(kCapacity);
+    QRandomGenerator random(44);
+
+    for (int i = 0; i < kNavigationCount; ++i) {
+        const quint32 op = random.bounded(100u);
+        if (op < 70) {
+            ring.push(RouteItem(nullptr, routeKey(int(random.bounded(quint32(kKeyCount))))));
+        } else if (op < 85) {
+            ring.remove(routeKey(int(random.bounded(quint32(kKeyCount)))));
+        } else {
+            ring.pop();
+        }
+
+        // 每个路由键至少对应一条有效记录，键的数量受容量约束
+        if (ring.size() > kCapacity || ring.keyCount() > ring.size()) {
+            QFAIL(qPrintable(QStringLiteral("bound exceeded after %1 operations: size %2, keys %3")
+                             .arg(i + 1).arg(ring.size()).arg(ring.keyCount())));
+        }
+    }
+
+    while (ring.pop()) {
+    }
+    QCOMPARE(ring.size(), 0);
+    QCOMPARE(ring.keyCount(), 0);
+}
+
+void RouteHistoryTest::historyMillionPushesStayBounded()
+{
+    StackedWidget stacked;
+    RouteHistory *history = RouteHistory::instance();
+    history->setMaximumHistory(kCapacity);
+
+    for (int i = 0; i < kNavigationCount; ++i) {
+        history->push(&stacked, routeKey(i));
+    }
+    QCOMPARE(history->size(), kCapacity);
+
+    for (int i = 0; i < kKeyCount; ++i) {
+        history->remove(routeKey(i));
+    }
+    QVERIFY(history->isEmpty());
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <QObject>
+
+/**
+ * @brief RouteRing / RouteHistory 的内存上界与删除语义
+ */
+class RouteHistoryTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void popMergesAdjacentAfterRemove();
+    void millionPushesStayBounded();
+    void mixedOperationsStayBounded();
+    void historyMillionPushesStayBounded();
+};
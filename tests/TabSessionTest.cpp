@@ -0,0 +1,154 @@
+#include "TabSessionTest.h"
+
+#include <QtTest>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include "TabBar/TabSession.h"
+
+namespace {
+constexpr int kTabCount = 5;
+constexpr int kUpdateCount = 2000;
+constexpr int kTruncatedBytes = 3;
+
+QString routeKey(int i)
+{
+    return QStringLiteral("tab_%1").arg(i);
+}
+
+TabSession::Tab makeTab(int i)
+{
+    TabSession::Tab tab;
+    tab.routeKey = routeKey(i);
+    tab.title = QStringLiteral("标签 %1").arg(i);
+    tab.iconPath = QStringLiteral(":/res/tab%1.svg").arg(i);
+    tab.state = QByteArray::number(i);
+    return tab;
+}
+
+void compareTabs(const QVector<TabSession::Tab> &actual, const QVector<TabSession::Tab> &expected)
+{
+    QCOMPARE(actual.size(), expected.size());
+    for (int i = 0; i < actual.size(); ++i) {
+        QCOMPARE(actual.at(i).routeKey, expected.at(i).routeKey);
+        QCOMPARE(actual.at(i).title, expected.at(i).title);
+        QCOMPARE(actual.at(i).iconPath, expected.at(i).iconPath);
+        QCOMPARE(actual.at(i).state, expected.at(i).state);
+    }
+}
+
+qint64 fileSize(const QString &filePath)
+{
+    return QFileInfo(filePath).size();
+}
+}
+
+void TabSessionTest::restoreRoundTrip()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString filePath = dir.filePath(QStringLiteral("tabs.session"));
+
+    QVector<TabSession::Tab> expected;
+    {
+        TabSession session(filePath);
+        QVERIFY(session.restore().isEmpty());
+
+        for (int i = 0; i < kTabCount; ++i) {
+            session.insertTab(i, makeTab(i));
+        }
+        session.moveTab(0, kTabCount - 1);
+        session.removeTab(routeKey(2));
+        session.setTabTitle(routeKey(3), QStringLiteral("改名"));
+        session.setPageState(routeKey(4), QByteArray("note"));
+        session.setCurrentTab(routeKey(3));
+
+        // 已不存在的标签不写记录
+        session.setTabTitle(routeKey(2), QStringLiteral("已关闭"));
+        session.setPageState(routeKey(2), QByteArray("stale"));
+
+        expected = session.tabs();
+        QCOMPARE(expected.size(), kTabCount - 1);
+        QCOMPARE(expected.last().routeKey, routeKey(0));
+    }
+
+    TabSession restored(filePath);
+    compareTabs(restored.restore(), expected);
+    QCOMPARE(restored.currentRouteKey(), routeKey(3));
+    QCOMPARE(restored.pageState(routeKey(4)), QByteArray("note"));
+    QVERIFY(restored.pageState(routeKey(2)).isEmpty());
+}
+
+void TabSessionTest::truncatedTailIsDropped()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString filePath = dir.filePath(QStringLiteral("tabs.session"));
+
+    QVector<TabSession::Tab> expected;
+    {
+        TabSession session(filePath);
+        session.restore();
+        for (int i = 0; i < kTabCount; ++i) {
+            session.insertTab(i, makeTab(i));
+        }
+        expected = session.tabs();
+
+        // 最后一条记录只写了一部分，模拟写入时进程退出
+        session.setTabTitle(routeKey(1), QStringLiteral("写了一半"));
+    }
+    {
+        QFile file(filePath);
+        QVERIFY(file.resize(fileSize(filePath) - kTruncatedBytes));
+    }
+
+    {
+        TabSession session(filePath);
+        compareTabs(session.restore(), expected);
+
+        // 回放后已重写为快照，之后追加的记录不受损坏尾部影响
+        session.setTabTitle(routeKey(1), QStringLiteral("重新写入"));
+        expected[1].title = QStringLiteral("重新写入");
+    }
+
+    TabSession restored(filePath);
+    compareTabs(restored.restore(), expected);
+}
+
+void TabSessionTest::compactionBoundsLogSize()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString filePath = dir.filePath(QStringLiteral("tabs.session"));
+
+    TabSession session(filePath);
+    session.restore();
+    for (int i = 0; i < kTabCount; ++i) {
+        session.insertTab(i, makeTab(i));
+    }
+    session.compact();
+    const qint64 snapshotSize = fileSize(filePath);
+
+    // 每次更新追加一条同样大小的记录
+    const QByteArray state(64, 'x');
+    session.setPageState(routeKey(0), state);
+    const qint64 recordSize = fileSize(filePath) - snapshotSize;
+    QVERIFY(recordSize > 0);
+
+    for (int i = 0; i < kUpdateCount; ++i) {
+        session.setPageState(routeKey(i % kTabCount), state + QByteArray::number(i % 10));
+    }
+
+    // 不压缩时日志会增长 kUpdateCount 条记录，压缩后只剩零头
+    QVERIFY2(fileSize(filePath) < snapshotSize + recordSize * kUpdateCount / 2,
+             qPrintable(QStringLiteral("log is %1 bytes").arg(fileSize(filePath))));
+
+    const QVector<TabSession::Tab> expected = session.tabs();
+    session.compact();
+    const qint64 compactedSize = fileSize(filePath);
+    QVERIFY(compactedSize < snapshotSize + recordSize * kTabCount);
+
+    TabSession restored(filePath);
+    compareTabs(restored.restore(), expected);
+    QCOMPARE(fileSize(filePath), compactedSize);
+}
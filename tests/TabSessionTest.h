@@ -0,0 +1,16 @@
+#pragma once
+
+#include <QObject>
+
+/**
+ * @brief TabSession 日志格式：回放还原、截断尾部的丢弃与日志压缩
+ */
+class TabSessionTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void restoreRoundTrip();
+    void truncatedTailIsDropped();
+    void compactionBoundsLogSize();
+};
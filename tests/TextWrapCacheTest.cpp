@@ -0,0 +1,102 @@
+#include "TextWrapCacheTest.h"
+
+#include <QtTest>
+#include <QAtomicInt>
+#include <QThreadPool>
+
+#include "TextWrap.h"
+#include "Common/TextWrapCache.h"
+
+namespace {
+constexpr int kThreadCount = 8;
+constexpr int kIterationCount = 4000;
+constexpr int kLargeCacheSize = 4096;
+constexpr int kTinyCacheSize = 16;
+constexpr int kDefaultCacheSize = 1024;
+
+QStringList corpus()
+{
+    return {
+        QStringLiteral("订单已发货，请注意查收"),
+        QStringLiteral("Your order has been shipped and will arrive soon"),
+        QStringLiteral("库存不足 SKU-20931 请及时补货"),
+        QStringLiteral("支付成功 payment confirmed 感谢您的购买"),
+        QStringLiteral("https://example.com/orders/1234567890/details"),
+        QStringLiteral("退款申请已受理（限时）refund request accepted"),
+        QStringLiteral("eShopOnQFluentKit"),
+        QStringLiteral("短"),
+        QString()
+    };
+}
+
+QList<int> widths()
+{
+    return {4, 10, 20, 40};
+}
+}
+
+void TextWrapCacheTest::cleanup()
+{
+    TextWrapCache::setCacheSize(kDefaultCacheSize);
+    TextWrapCache::clearCache();
+    TextWrapCache::resetStatistics();
+}
+
+void TextWrapCacheTest::concurrentWrapMatchesTextWrap_data()
+{
+    QTest::addColumn<int>("cacheSize");
+
+    // 容量充足时几乎全部命中；容量极小时各线程不断淘汰彼此刚写入的条目
+    QTest::newRow("hits") << kLargeCacheSize;
+    QTest::newRow("evictions") << kTinyCacheSize;
+}
+
+void TextWrapCacheTest::concurrentWrapMatchesTextWrap()
+{
+    QFETCH(int, cacheSize);
+
+    const QStringList texts = corpus();
+    const QList<int> wrapWidths = widths();
+
+    // 期望结果在主线程用库的 TextWrap 计算，两种 once 都覆盖
+    const int keyCount = texts.size() * wrapWidths.size() * 2;
+    QVector<std::pair<QString, bool>> expected;
+    expected.reserve(keyCount);
+    for (int key = 0; key < keyCount; ++key) {
+        const QString &text = texts.at(key % texts.size());
+        const int width = wrapWidths.at((key / texts.size()) % wrapWidths.size());
+        const bool once = key / (texts.size() * wrapWidths.size()) == 1;
+        expected.append(TextWrap::wrap(text, width, once));
+    }
+
+    TextWrapCache::setCacheSize(cacheSize);
+    TextWrapCache::clearCache();
+    TextWrapCache::resetStatistics();
+
+    QAtomicInt mismatches;
+    QThreadPool pool;
+    pool.setMaxThreadCount(kThreadCount);
+    for (int thread = 0; thread < kThreadCount; ++thread) {
+        pool.start([&, thread]() {
+            for (int i = 0; i < kIterationCount; ++i) {
+                // 各线程以不同步长遍历同一组键，同一时刻总有多个线程读写同一个键
+                const int key = (i * (thread + 1)) % keyCount;
+                const QString &text = texts.at(key % texts.size());
+                const int width = wrapWidths.at((key / texts.size()) % wrapWidths.size());
+                const bool once = key / (texts.size() * wrapWidths.size()) == 1;
+
+                const std::pair<QString, bool> actual = TextWrapCache::wrap(text, width, once);
+                if (actual.first != expected.at(key).first || actual.second != expected.at(key).second) {
+                    mismatches.ref();
+                }
+            }
+        });
+    }
+    pool.waitForDone();
+
+    QCOMPARE(mismatches.loadAcquire(), 0);
+
+    // 每次查询恰好计一次命中或未命中，并发下计数不丢失
+    const TextWrapCache::Statistics statistics = TextWrapCache::statistics();
+    QCOMPARE(statistics.hits + statistics.misses, qint64(kThreadCount) * kIterationCount);
+}
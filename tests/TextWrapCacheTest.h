@@ -0,0 +1,16 @@
+#pragma once
+
+#include <QObject>
+
+/**
+ * @brief TextWrapCache 在多线程并发读写同一批键时与 TextWrap 的结果一致
+ */
+class TextWrapCacheTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void cleanup();
+    void concurrentWrapMatchesTextWrap_data();
+    void concurrentWrapMatchesTextWrap();
+};
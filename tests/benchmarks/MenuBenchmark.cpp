@@ -0,0 +1,99 @@
+#include "MenuBenchmark.h"
+
+#include <QtTest>
+#include <QAction>
+#include <QElapsedTimer>
+
+#include "Menu/ActionListMenu.h"
+
+namespace {
+constexpr int kSampleCount = 10;
+constexpr int kWarmActionCount = 1000;
+const QPoint kMenuPos(100, 100);
+
+void addActions(ActionListMenu *menu, QObject *owner, int count)
+{
+    QList<QAction *> actions;
+    actions.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        actions.append(new QAction(QStringLiteral("Action %1").arg(i), owner));
+    }
+    menu->addActions(actions);
+}
+
+/**
+ * @brief 打开菜单并处理掉随之投递的布局和绘制事件，返回耗时（纳秒）
+ */
+qint64 measureOpen(ActionListMenu *menu)
+{
+    QElapsedTimer timer;
+    timer.start();
+    menu->exec(kMenuPos, false);
+    QCoreApplication::processEvents();
+    return timer.nsecsElapsed();
+}
+}
+
+void MenuBenchmark::openLatency_data()
+{
+    QTest::addColumn<int>("actionCount");
+
+    QTest::newRow("10 actions") << 10;
+    QTest::newRow("100 actions") << 100;
+    QTest::newRow("1000 actions") << 1000;
+    QTest::newRow("10000 actions") << 10000;
+}
+
+void MenuBenchmark::openLatency()
+{
+    QFETCH(int, actionCount);
+
+    // 每个样本都是新建菜单的第一次打开，构建菜单不计入耗时
+    qint64 total = 0;
+    for (int i = 0; i < kSampleCount; ++i) {
+        QObject owner;
+        ActionListMenu menu;
+        addActions(&menu, &owner, actionCount);
+
+        total += measureOpen(&menu);
+        QVERIFY(menu.isVisible());
+        menu.hideMenu();
+    }
+
+    QTest::setBenchmarkResult(qreal(total) / kSampleCount / 1000000, QTest::WalltimeMilliseconds);
+}
+
+void MenuBenchmark::warmOpen_data()
+{
+    QTest::addColumn<QString>("mode");
+
+    QTest::newRow("first open") << QStringLiteral("first");
+    QTest::newRow("first open after warmUp") << QStringLiteral("warm");
+    QTest::newRow("reopen") << QStringLiteral("reopen");
+}
+
+void MenuBenchmark::warmOpen()
+{
+    QFETCH(QString, mode);
+
+    qint64 total = 0;
+    for (int i = 0; i < kSampleCount; ++i) {
+        QObject owner;
+        ActionListMenu menu;
+        addActions(&menu, &owner, kWarmActionCount);
+
+        // 预热和第一次打开都不计入耗时，只比较被测的那一次
+        if (mode == QLatin1String("warm")) {
+            menu.warmUp();
+            QVERIFY(menu.isWarm());
+        } else if (mode == QLatin1String("reopen")) {
+            measureOpen(&menu);
+            menu.hideMenu();
+        }
+
+        total += measureOpen(&menu);
+        menu.hideMenu();
+    }
+
+    QTest::setBenchmarkResult(qreal(total) / kSampleCount / 1000000, QTest::WalltimeMilliseconds);
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <QObject>
+
+/**
+ * @brief ActionListMenu 的打开延迟：随动作数量的变化，以及预热前后的对比
+ */
+class MenuBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void openLatency_data();
+    void openLatency();
+    void warmOpen_data();
+    void warmOpen();
+};
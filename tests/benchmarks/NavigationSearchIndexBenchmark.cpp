@@ -0,0 +1,58 @@
+#include "NavigationSearchIndexBenchmark.h"
+
+#include <QtTest>
+
+#include "Navigation/NavigationSearchIndex.h"
+
+namespace {
+constexpr int kItemCount = 10000;
+
+QStringList vocabulary()
+{
+    return {
+        QStringLiteral("Orders"), QStringLiteral("Inventory"), QStringLiteral("Payments"),
+        QStringLiteral("Customers"), QStringLiteral("Reports"), QStringLiteral("Settings"),
+        QStringLiteral("Shipping"), QStringLiteral("Returns"), QStringLiteral("Coupons"),
+        QStringLiteral("Analytics"), QStringLiteral("订单"), QStringLiteral("库存"),
+        QStringLiteral("支付"), QStringLiteral("客户"), QStringLiteral("报表"),
+        QStringLiteral("物流"), QStringLiteral("退款"), QStringLiteral("优惠券")
+    };
+}
+
+// 与 NavigationSearchIndexTest 使用相同的条目
+QString itemText(int i)
+{
+    static const QStringList words = vocabulary();
+    return QStringLiteral("%1 %2 %3")
+            .arg(words.at(i % words.size()), words.at((i / words.size()) % words.size()))
+            .arg(i);
+}
+}
+
+void NavigationSearchIndexBenchmark::search_data()
+{
+    QTest::addColumn<QString>("query");
+
+    QTest::newRow("single character") << QStringLiteral("r");
+    QTest::newRow("prefix") << QStringLiteral("ord");
+    QTest::newRow("substring") << QStringLiteral("ventory");
+    QTest::newRow("two words") << QStringLiteral("orders inv");
+    QTest::newRow("route key") << QStringLiteral("page-4321");
+    QTest::newRow("number") << QStringLiteral("9999");
+    QTest::newRow("cjk") << QStringLiteral("库存");
+    QTest::newRow("no match") << QStringLiteral("zzzz");
+}
+
+void NavigationSearchIndexBenchmark::search()
+{
+    QFETCH(QString, query);
+
+    NavigationSearchIndex index;
+    for (int i = 0; i < kItemCount; ++i) {
+        index.insert(QStringLiteral("page-%1").arg(i), itemText(i));
+    }
+
+    QBENCHMARK {
+        index.search(query);
+    }
+}
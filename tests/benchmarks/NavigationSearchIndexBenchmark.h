@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QObject>
+
+/**
+ * @brief 10000 个导航项下各类查询的耗时
+ */
+class NavigationSearchIndexBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void search_data();
+    void search();
+};
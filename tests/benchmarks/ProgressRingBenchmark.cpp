@@ -0,0 +1,83 @@
+#include "ProgressRingBenchmark.h"
+
+#include <QImage>
+#include <QtTest>
+#include <QVector>
+#include <QGridLayout>
+#include <QAbstractAnimation>
+
+#include "QFluent/Progress/IndeterminateProgressRing.h"
+#include "Progress/SpriteProgressRing.h"
+
+namespace {
+constexpr int kColumnCount = 10;
+constexpr int kRingSize = 80;
+}
+
+void ProgressRingBenchmark::animateRings_data()
+{
+    QTest::addColumn<bool>("isSprite");
+    QTest::addColumn<int>("ringCount");
+
+    QTest::newRow("IndeterminateProgressRing x10") << false << 10;
+    QTest::newRow("SpriteProgressRing x10") << true << 10;
+    QTest::newRow("IndeterminateProgressRing x100") << false << 100;
+    QTest::newRow("SpriteProgressRing x100") << true << 100;
+}
+
+void ProgressRingBenchmark::animateRings()
+{
+    QFETCH(bool, isSprite);
+    QFETCH(int, ringCount);
+
+    QWidget container;
+    auto *layout = new QGridLayout(&container);
+
+    QVector<SpriteProgressRing *> sprites;
+    QVector<QAbstractAnimation *> animations;
+    for (int i = 0; i < ringCount; ++i) {
+        QProgressBar *ring = nullptr;
+        if (isSprite) {
+            auto *sprite = new SpriteProgressRing(&container);
+            sprites.append(sprite);
+            ring = sprite;
+        } else {
+            ring = new IndeterminateProgressRing(&container);
+        }
+        ring->setFixedSize(kRingSize, kRingSize);
+        layout->addWidget(ring, i / kColumnCount, i % kColumnCount);
+    }
+
+    container.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&container));
+
+    // 库内进度环由各自的顶层动画组驱动，暂停后按帧手动推进
+    if (!isSprite) {
+        for (QAbstractAnimation *animation : container.findChildren<QAbstractAnimation *>()) {
+            if (!animation->group()) {
+                animation->pause();
+                animations.append(animation);
+            }
+        }
+        QVERIFY(!animations.isEmpty());
+    }
+
+    QImage image(container.size() * container.devicePixelRatioF(), QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(container.devicePixelRatioF());
+
+    QBENCHMARK {
+        for (int frame = 0; frame < ProgressRingSprites::kFrameCount; ++frame) {
+            if (isSprite) {
+                for (SpriteProgressRing *sprite : sprites) {
+                    sprite->setFrame(frame);
+                }
+            } else {
+                const int time = frame * ProgressRingSprites::kCycleDuration / ProgressRingSprites::kFrameCount;
+                for (QAbstractAnimation *animation : animations) {
+                    animation->setCurrentTime(time);
+                }
+            }
+            container.render(&image);
+        }
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QObject>
+
+/**
+ * @brief N 个不定进度环播放一个完整周期：IndeterminateProgressRing 与 SpriteProgressRing 对比
+ */
+class ProgressRingBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void animateRings_data();
+    void animateRings();
+};
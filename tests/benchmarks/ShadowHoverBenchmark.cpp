@@ -0,0 +1,106 @@
+#include "ShadowHoverBenchmark.h"
+
+#include <QImage>
+#include <QtTest>
+#include <QVector>
+#include <QGridLayout>
+#include <QGraphicsDropShadowEffect>
+
+#include "QFluent/CardWidget.h"
+#include "Common/NinePatchShadow.h"
+
+namespace {
+constexpr int kColumnCount = 10;
+constexpr int kCardCount = 100;
+constexpr int kCardSpacing = 24;
+constexpr int kBlurRadius = 38;
+constexpr int kOffsetY = 5;
+constexpr int kDuration = 150;
+constexpr int kFrameCount = 10;
+const QSize kCardSize(140, 80);
+const QColor kNormalColor(0, 0, 0, 0);
+const QColor kHoverColor(0, 0, 0, 75);
+
+void sendHover(QWidget *widget, QEvent::Type type)
+{
+    QEvent event(type);
+    QCoreApplication::sendEvent(widget, &event);
+}
+}
+
+void ShadowHoverBenchmark::hoverCards_data()
+{
+    QTest::addColumn<bool>("isNinePatch");
+
+    QTest::newRow("QGraphicsDropShadowEffect") << false;
+    QTest::newRow("NinePatchShadow") << true;
+}
+
+void ShadowHoverBenchmark::hoverCards()
+{
+    QFETCH(bool, isNinePatch);
+
+    QWidget container;
+    auto *layout = new QGridLayout(&container);
+    layout->setSpacing(kCardSpacing);
+    layout->setContentsMargins(kCardSpacing, kCardSpacing, kCardSpacing, kCardSpacing);
+
+    QVector<CardWidget *> cards;
+    QVector<QGraphicsDropShadowEffect *> effects;
+    QVector<NinePatchShadowAnimation *> animations;
+    for (int i = 0; i < kCardCount; ++i) {
+        auto *card = new CardWidget(&container);
+        card->setFixedSize(kCardSize);
+        layout->addWidget(card, i / kColumnCount, i % kColumnCount);
+        cards.append(card);
+
+        if (isNinePatch) {
+            auto *animation = new NinePatchShadowAnimation(card, kNormalColor, kHoverColor);
+            animation->setBlurRadius(kBlurRadius);
+            animation->setOffset(0, kOffsetY);
+            animations.append(animation);
+        } else {
+            auto *effect = new QGraphicsDropShadowEffect(card);
+            effect->setBlurRadius(kBlurRadius);
+            effect->setOffset(0, kOffsetY);
+            effect->setColor(kNormalColor);
+            card->setGraphicsEffect(effect);
+            effects.append(effect);
+        }
+    }
+
+    container.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&container));
+
+    QImage image(container.size() * container.devicePixelRatioF(), QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(container.devicePixelRatioF());
+
+    // 动画暂停后按帧手动推进，每帧更新全部卡片再整体绘制一次
+    const auto transition = [&](QEvent::Type type, const QColor &from, const QColor &to) {
+        for (int i = 0; i < kCardCount; ++i) {
+            sendHover(cards.at(i), type);
+            if (isNinePatch) {
+                animations.at(i)->pause();
+            }
+        }
+
+        for (int frame = 1; frame <= kFrameCount; ++frame) {
+            const int time = kDuration * frame / kFrameCount;
+            for (int i = 0; i < kCardCount; ++i) {
+                if (isNinePatch) {
+                    animations.at(i)->setCurrentTime(time);
+                } else {
+                    QColor color = to;
+                    color.setAlpha(from.alpha() + (to.alpha() - from.alpha()) * frame / kFrameCount);
+                    effects.at(i)->setColor(color);
+                }
+            }
+            container.render(&image);
+        }
+    };
+
+    QBENCHMARK {
+        transition(QEvent::Enter, kNormalColor, kHoverColor);
+        transition(QEvent::Leave, kHoverColor, kNormalColor);
+    }
+}
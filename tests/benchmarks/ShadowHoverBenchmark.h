@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QObject>
+
+/**
+ * @brief 100 张带阴影卡片的悬停过渡：QGraphicsDropShadowEffect 与九宫格阴影对比
+ */
+class ShadowHoverBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void hoverCards_data();
+    void hoverCards();
+};
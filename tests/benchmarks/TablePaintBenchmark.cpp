@@ -0,0 +1,72 @@
+#include "TablePaintBenchmark.h"
+
+#include <QImage>
+#include <QtTest>
+#include <QHeaderView>
+#include <QStandardItemModel>
+
+#include "QFluent/TableView.h"
+#include "View/CachedTableItemDelegate.h"
+
+namespace {
+constexpr int kRowCount = 200;
+constexpr int kColumnCount = 30;
+constexpr int kRowHeight = 38;
+constexpr int kSelectedRowStep = 7;
+const QSize kScreenSize(1920, 1080);
+}
+
+void TablePaintBenchmark::paintFullScreen_data()
+{
+    QTest::addColumn<bool>("isCached");
+
+    QTest::newRow("TableItemDelegate") << false;
+    QTest::newRow("CachedTableItemDelegate") << true;
+}
+
+void TablePaintBenchmark::paintFullScreen()
+{
+    QFETCH(bool, isCached);
+
+    QStandardItemModel model(kRowCount, kColumnCount);
+    for (int row = 0; row < kRowCount; ++row) {
+        for (int column = 0; column < kColumnCount; ++column) {
+            auto *item = new QStandardItem(QStringLiteral("Row %1 / Column %2").arg(row).arg(column));
+            if (column == 0) {
+                item->setCheckable(true);
+                item->setCheckState(row % 2 ? Qt::Checked : Qt::Unchecked);
+            }
+            model.setItem(row, column, item);
+        }
+    }
+
+    TableView view;
+    view.setModel(&model);
+
+    // 两组使用相同的固定行高，只比较代理本身的绘制开销
+    view.verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    view.verticalHeader()->setDefaultSectionSize(kRowHeight);
+    if (isCached) {
+        auto *delegate = new CachedTableItemDelegate(&view);
+        delegate->setUniformRowHeight(kRowHeight);
+        // TableBase::setItemDelegate 只接受库内的 TableItemDelegate
+        view.QAbstractItemView::setItemDelegate(delegate);
+    }
+    view.resize(kScreenSize);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    // 选中若干行，覆盖指示条和选中背景
+    for (int row = 0; row < kRowCount; row += kSelectedRowStep) {
+        view.selectionModel()->select(model.index(row, 0),
+                                      QItemSelectionModel::Select | QItemSelectionModel::Rows);
+    }
+
+    QWidget *viewport = view.viewport();
+    QImage image(viewport->size() * viewport->devicePixelRatioF(), QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(viewport->devicePixelRatioF());
+
+    QBENCHMARK {
+        viewport->render(&image);
+    }
+}
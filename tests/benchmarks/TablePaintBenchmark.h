@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QObject>
+
+/**
+ * @brief 30 列表格整屏重绘：库自带代理与 CachedTableItemDelegate 对比
+ */
+class TablePaintBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void paintFullScreen_data();
+    void paintFullScreen();
+};
@@ -0,0 +1,113 @@
+#include "TextWrapBenchmark.h"
+
+#include <QtTest>
+#include <QRandomGenerator>
+
+#include "TextWrap.h"
+#include "Common/TextWrapCache.h"
+
+namespace {
+constexpr int kCorpusSize = 2000;
+constexpr int kMinWords = 8;
+constexpr int kMaxWords = 40;
+constexpr int kWrapWidth = 40;
+
+QStringList cjkPhrases()
+{
+    return {
+        QStringLiteral("订单已发货"), QStringLiteral("库存不足"), QStringLiteral("支付成功"),
+        QStringLiteral("收货地址"), QStringLiteral("优惠券"), QStringLiteral("商品详情"),
+        QStringLiteral("退款申请已受理"), QStringLiteral("，"), QStringLiteral("。"),
+        QStringLiteral("（限时）")
+    };
+}
+
+QStringList latinWords()
+{
+    return {
+        QStringLiteral("order"), QStringLiteral("shipped"), QStringLiteral("eShopOnQFluentKit"),
+        QStringLiteral("inventory"), QStringLiteral("SKU-20931"), QStringLiteral("payment"),
+        QStringLiteral("confirmed"), QStringLiteral("https://example.com/orders/12345"),
+        QStringLiteral("QFluent"), QStringLiteral("v2.1")
+    };
+}
+}
+
+void TextWrapBenchmark::initTestCase()
+{
+    // 固定种子，每次运行语料相同
+    const QStringList cjk = cjkPhrases();
+    const QStringList latin = latinWords();
+    QRandomGenerator random(31);
+    m_corpus.reserve(kCorpusSize);
+    for (int i = 0; i < kCorpusSize; ++i) {
+        QString text;
+        const int words = int(random.bounded(kMinWords, kMaxWords + 1));
+        for (int w = 0; w < words; ++w) {
+            if (random.bounded(2) == 0) {
+                text += cjk.at(random.bounded(cjk.size()));
+            } else {
+                if (!text.isEmpty()) {
+                    text += QLatin1Char(' ');
+                }
+                text += latin.at(random.bounded(latin.size()));
+            }
+        }
+        m_corpus.append(text);
+    }
+}
+
+void TextWrapBenchmark::wrapMixedCorpus_data()
+{
+    QTest::addColumn<bool>("isCached");
+    QTest::addColumn<bool>("isWarm");
+    QTest::addColumn<bool>("once");
+
+    for (const bool once : {false, true}) {
+        const char *suffix = once ? "once" : "all";
+        QTest::addRow("TextWrap cold %s", suffix) << false << false << once;
+        QTest::addRow("TextWrap warm %s", suffix) << false << true << once;
+        QTest::addRow("TextWrapCache cold %s", suffix) << true << false << once;
+        QTest::addRow("TextWrapCache warm %s", suffix) << true << true << once;
+    }
+}
+
+void TextWrapBenchmark::wrapMixedCorpus()
+{
+    QFETCH(bool, isCached);
+    QFETCH(bool, isWarm);
+    QFETCH(bool, once);
+
+    const auto wrap = [isCached, once](const QString &text) {
+        return isCached ? TextWrapCache::wrap(text, kWrapWidth, once)
+                        : TextWrap::wrap(text, kWrapWidth, once);
+    };
+
+    const QStringList &corpus = m_corpus;
+    TextWrap::clearCache();
+    TextWrapCache::clearCache();
+    TextWrapCache::setCacheSize(kCorpusSize * 2);
+    for (const QString &text : corpus) {
+        wrap(text);
+    }
+
+    int wrapped = 0;
+    QBENCHMARK {
+        if (!isWarm) {
+            TextWrap::clearCache();
+            TextWrapCache::clearCache();
+        }
+        for (const QString &text : corpus) {
+            wrapped += wrap(text).second ? 1 : 0;
+        }
+    }
+    QVERIFY(wrapped > 0);
+
+    // 两种实现的折行规则一致
+    for (const QString &text : corpus) {
+        const auto expected = TextWrap::wrap(text, kWrapWidth, once);
+        const auto actual = TextWrapCache::wrap(text, kWrapWidth, once);
+        QCOMPARE(actual.first, expected.first);
+        QCOMPARE(actual.second, expected.second);
+    }
+}
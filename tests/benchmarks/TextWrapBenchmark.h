@@ -0,0 +1,20 @@
+#pragma once
+
+#include <QObject>
+#include <QStringList>
+
+/**
+ * @brief 中英混排语料的折行：库自带 TextWrap 与 TextWrapCache 在冷、热缓存下对比
+ */
+class TextWrapBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void wrapMixedCorpus_data();
+    void wrapMixedCorpus();
+
+private:
+    QStringList m_corpus;
+};
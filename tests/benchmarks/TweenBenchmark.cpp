@@ -0,0 +1,98 @@
+#include "TweenBenchmark.h"
+
+#include <memory>
+#include <vector>
+
+#include <QtTest>
+#include <QVector>
+#include <QElapsedTimer>
+#include <QVariantAnimation>
+
+#include "Common/FluentTween.h"
+
+namespace {
+constexpr int kTweenCount = 10000;
+constexpr int kDuration = 500;
+constexpr int kTimeout = 10000;
+
+/**
+ * @brief 从第一个补间写值到最后一个补间写值的时间，即一帧推进全部补间的开销
+ */
+struct FrameCost {
+    QElapsedTimer timer;
+    qint64 totalNsecs = 0;
+    int frames = 0;
+
+    void update(int index)
+    {
+        if (index == 0) {
+            timer.start();
+        } else if (index == kTweenCount - 1 && timer.isValid()) {
+            totalNsecs += timer.nsecsElapsed();
+            ++frames;
+            timer.invalidate();
+        }
+    }
+};
+}
+
+void TweenBenchmark::concurrentTweens_data()
+{
+    QTest::addColumn<bool>("isFluentTween");
+
+    QTest::newRow("QVariantAnimation") << false;
+    QTest::newRow("FluentTween") << true;
+}
+
+void TweenBenchmark::concurrentTweens()
+{
+    QFETCH(bool, isFluentTween);
+
+    QVector<qreal> values(kTweenCount);
+    FrameCost cost;
+
+    if (isFluentTween) {
+        std::vector<std::unique_ptr<FluentTween<qreal>>> tweens;
+        tweens.reserve(kTweenCount);
+        for (int i = 0; i < kTweenCount; ++i) {
+            tweens.emplace_back(new FluentTween<qreal>([&values, &cost, i](const qreal &value) {
+                values[i] = value;
+                cost.update(i);
+            }));
+            tweens.back()->setDuration(kDuration);
+            tweens.back()->setEasing(QEasingCurve::OutQuad);
+        }
+
+        for (const auto &tween : tweens) {
+            tween->start(0, 1);
+        }
+        QTRY_VERIFY_WITH_TIMEOUT(AnimationClock::instance()->activeCount() == 0, kTimeout);
+    } else {
+        int remaining = kTweenCount;
+        std::vector<std::unique_ptr<QVariantAnimation>> animations;
+        animations.reserve(kTweenCount);
+        for (int i = 0; i < kTweenCount; ++i) {
+            auto *animation = new QVariantAnimation;
+            animation->setStartValue(qreal(0));
+            animation->setEndValue(qreal(1));
+            animation->setDuration(kDuration);
+            animation->setEasingCurve(QEasingCurve::OutQuad);
+            QObject::connect(animation, &QVariantAnimation::valueChanged, [&values, &cost, i](const QVariant &value) {
+                values[i] = value.toReal();
+                cost.update(i);
+            });
+            QObject::connect(animation, &QAbstractAnimation::finished, [&remaining] { --remaining; });
+            animations.emplace_back(animation);
+        }
+
+        for (const auto &animation : animations) {
+            animation->start();
+        }
+        QTRY_VERIFY_WITH_TIMEOUT(remaining == 0, kTimeout);
+    }
+
+    QVERIFY(cost.frames > 0);
+    QCOMPARE(values.first(), qreal(1));
+    QCOMPARE(values.last(), qreal(1));
+    QTest::setBenchmarkResult(qreal(cost.totalNsecs) / cost.frames / 1000000, QTest::WalltimeMilliseconds);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QObject>
+
+/**
+ * @brief 10000 个同时运行的补间每帧的推进开销：QVariantAnimation 与 FluentTween 对比
+ */
+class TweenBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void concurrentTweens_data();
+    void concurrentTweens();
+};
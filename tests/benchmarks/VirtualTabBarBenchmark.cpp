@@ -0,0 +1,65 @@
+#include "VirtualTabBarBenchmark.h"
+
+#include <QtTest>
+#include <QMouseEvent>
+
+#include "TabBar/VirtualTabBar.h"
+
+namespace {
+constexpr int kBarWidth = 1200;
+constexpr int kDragStep = 4;
+constexpr int kDraggedTabs = 20;
+
+void sendMouse(QWidget *widget, QEvent::Type type, const QPoint &pos,
+               Qt::MouseButton button, Qt::MouseButtons buttons)
+{
+    QMouseEvent event(type, pos, widget->mapToGlobal(pos), button, buttons, Qt::NoModifier);
+    QCoreApplication::sendEvent(widget, &event);
+}
+}
+
+void VirtualTabBarBenchmark::dragAcrossTabs_data()
+{
+    QTest::addColumn<int>("tabCount");
+
+    QTest::newRow("50 tabs") << 50;
+    QTest::newRow("500 tabs") << 500;
+    QTest::newRow("5000 tabs") << 5000;
+}
+
+void VirtualTabBarBenchmark::dragAcrossTabs()
+{
+    QFETCH(int, tabCount);
+
+    VirtualTabBar bar;
+    bar.setMovable(true);
+    bar.setScrollable(true);
+    for (int i = 0; i < tabCount; ++i) {
+        bar.addTab(QStringLiteral("tab-%1").arg(i), QStringLiteral("Tab %1").arg(i));
+    }
+    bar.resize(kBarWidth, bar.sizeHint().height());
+    bar.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&bar));
+
+    bar.setCurrentIndex(0);
+    TabItem *item = bar.tabItem(0);
+    QVERIFY(item);
+
+    // 拖动中的标签始终保持实例化，坐标统一换算到标签栏再映射回标签
+    const QPoint start = item->mapTo(&bar, item->rect().center());
+    const int distance = kDraggedTabs * bar.tabRect(0).width();
+
+    QBENCHMARK {
+        sendMouse(item, QEvent::MouseButtonPress, item->mapFrom(&bar, start), Qt::LeftButton, Qt::LeftButton);
+        for (int dx = 0; dx <= distance; dx += kDragStep) {
+            sendMouse(item, QEvent::MouseMove, item->mapFrom(&bar, start + QPoint(dx, 0)), Qt::NoButton, Qt::LeftButton);
+        }
+        for (int dx = distance; dx >= 0; dx -= kDragStep) {
+            sendMouse(item, QEvent::MouseMove, item->mapFrom(&bar, start + QPoint(dx, 0)), Qt::NoButton, Qt::LeftButton);
+        }
+        sendMouse(item, QEvent::MouseButtonRelease, item->mapFrom(&bar, start), Qt::LeftButton, Qt::NoButton);
+    }
+
+    QCOMPARE(bar.count(), tabCount);
+    QCOMPARE(bar.routeKey(bar.currentIndex()), QStringLiteral("tab-0"));
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QObject>
+
+/**
+ * @brief VirtualTabBar 拖动压力：开销应只与可见标签数有关，与标签总数无关
+ */
+class VirtualTabBarBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void dragAcrossTabs_data();
+    void dragAcrossTabs();
+};
@@ -0,0 +1,36 @@
+#include <QApplication>
+#include <QtTest>
+
+#include "MenuBenchmark.h"
+#include "NavigationSearchIndexBenchmark.h"
+#include "ProgressRingBenchmark.h"
+#include "ShadowHoverBenchmark.h"
+#include "TablePaintBenchmark.h"
+#include "TextWrapBenchmark.h"
+#include "TweenBenchmark.h"
+#include "VirtualTabBarBenchmark.h"
+
+namespace {
+template <typename Benchmark>
+int runBenchmark(int argc, char *argv[])
+{
+    Benchmark benchmark;
+    return QTest::qExec(&benchmark, argc, argv);
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+
+    int status = 0;
+    status |= runBenchmark<VirtualTabBarBenchmark>(argc, argv);
+    status |= runBenchmark<TablePaintBenchmark>(argc, argv);
+    status |= runBenchmark<TextWrapBenchmark>(argc, argv);
+    status |= runBenchmark<ShadowHoverBenchmark>(argc, argv);
+    status |= runBenchmark<TweenBenchmark>(argc, argv);
+    status |= runBenchmark<ProgressRingBenchmark>(argc, argv);
+    status |= runBenchmark<MenuBenchmark>(argc, argv);
+    status |= runBenchmark<NavigationSearchIndexBenchmark>(argc, argv);
+    return status;
+}
@@ -0,0 +1,32 @@
+#include <QApplication>
+#include <QtTest>
+
+#include "ConcurrentSortFilterProxyModelTest.h"
+#include "ItemViewPopulatorTest.h"
+#include "NavigationSearchIndexTest.h"
+#include "RouteHistoryTest.h"
+#include "TabSessionTest.h"
+#include "TextWrapCacheTest.h"
+
+namespace {
+template <typename Test>
+int runTest(int argc, char *argv[])
+{
+    Test test;
+    return QTest::qExec(&test, argc, argv);
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+
+    int status = 0;
+    status |= runTest<RouteHistoryTest>(argc, argv);
+    status |= runTest<NavigationSearchIndexTest>(argc, argv);
+    status |= runTest<ConcurrentSortFilterProxyModelTest>(argc, argv);
+    status |= runTest<ItemViewPopulatorTest>(argc, argv);
+    status |= runTest<TabSessionTest>(argc, argv);
+    status |= runTest<TextWrapCacheTest>(argc, argv);
+    return status;
+}